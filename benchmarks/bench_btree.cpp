@@ -0,0 +1,183 @@
+#include <benchmark/benchmark.h>
+#include <quartz/btree.hpp>
+#include <quartz/random.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using std_map   = std::map<qz::u64, qz::u64>;
+using btree_map = qz::btree_map<qz::u64, qz::u64>;
+
+constexpr qz::usz lookup_count = qz::usz{1} << 16;
+constexpr qz::usz scan_length  = 256;
+
+// sorted, unique random keys.
+std::vector<qz::u64> make_keys(qz::usz count)
+{
+    qz::xoshiro256pp engine(42);
+    std::vector<qz::u64> keys(count);
+    for (auto &key : keys)
+    {
+        key = engine();
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+// keys looked up in random order, all of which are present.
+std::vector<qz::u64> make_lookups(const std::vector<qz::u64> &keys)
+{
+    qz::xoshiro256pp engine(7);
+    std::vector<qz::u64> lookups(lookup_count);
+    for (auto &lookup : lookups)
+    {
+        lookup = keys[qz::uniform_int(engine, keys.size())];
+    }
+    return lookups;
+}
+
+template <class Map>
+void load(Map &map, const std::vector<qz::u64> &keys)
+{
+    if constexpr (std::is_same_v<Map, std_map>)
+    {
+        for (const auto key : keys)
+        {
+            map.emplace_hint(map.end(), key, key);
+        }
+    }
+    else
+    {
+        std::vector<std::pair<qz::u64, qz::u64>> pairs;
+        pairs.reserve(keys.size());
+        for (const auto key : keys)
+        {
+            pairs.emplace_back(key, key);
+        }
+        map.bulk_load(pairs.begin(), pairs.end());
+    }
+}
+
+// the benchmark functions run several times per size, so the last map built is kept around. Only one is kept, since
+// at the largest size a std::map takes over a gigabyte.
+template <class Map>
+const Map &cached_map(const std::vector<qz::u64> &keys)
+{
+    static std::unique_ptr<Map> map;
+    static qz::usz size = 0;
+    if (size != keys.size())
+    {
+        map.reset();
+        map = std::make_unique<Map>();
+        load(*map, keys);
+        size = keys.size();
+    }
+    return *map;
+}
+
+const std::vector<qz::u64> &cached_keys(qz::usz count)
+{
+    static std::vector<qz::u64> keys;
+    static qz::usz size = 0;
+    if (size != count)
+    {
+        keys = make_keys(count);
+        size = count;
+    }
+    return keys;
+}
+
+template <class Map>
+void bm_find(benchmark::State &state)
+{
+    const auto &keys   = cached_keys(static_cast<qz::usz>(state.range(0)));
+    const auto &map    = cached_map<Map>(keys);
+    const auto lookups = make_lookups(keys);
+
+    qz::usz index = 0;
+    qz::u64 sum   = 0;
+    for (auto _ : state)
+    {
+        sum += map.find(lookups[index++ % lookup_count])->second;
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+void bm_range_scan(benchmark::State &state)
+{
+    const auto &keys   = cached_keys(static_cast<qz::usz>(state.range(0)));
+    const auto &map    = cached_map<Map>(keys);
+    const auto lookups = make_lookups(keys);
+
+    qz::usz index = 0;
+    qz::u64 sum   = 0;
+    for (auto _ : state)
+    {
+        auto it = map.lower_bound(lookups[index++ % lookup_count]);
+        for (qz::usz i = 0; i < scan_length && it != map.end(); ++i, ++it)
+        {
+            sum += it->second;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(scan_length));
+}
+
+template <class Map>
+void bm_insert_random(benchmark::State &state)
+{
+    const auto count = static_cast<qz::usz>(state.range(0));
+    std::vector<qz::u64> keys(count);
+    qz::xoshiro256pp engine(42);
+    for (auto &key : keys)
+    {
+        key = engine();
+    }
+
+    for (auto _ : state)
+    {
+        Map map;
+        for (const auto key : keys)
+        {
+            map.try_emplace(key, key);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(count));
+}
+
+template <class Map>
+void bm_load_sorted(benchmark::State &state)
+{
+    const auto keys = make_keys(static_cast<qz::usz>(state.range(0)));
+    for (auto _ : state)
+    {
+        Map map;
+        load(map, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(keys.size()));
+}
+
+} // namespace
+
+// 1M, 4M & 16M keys. At 100M keys a std::map takes over 6 GB.
+BENCHMARK_TEMPLATE(bm_find, std_map)->RangeMultiplier(4)->Range(1 << 20, 1 << 24);
+BENCHMARK_TEMPLATE(bm_find, btree_map)->RangeMultiplier(4)->Range(1 << 20, 1 << 24);
+
+BENCHMARK_TEMPLATE(bm_range_scan, std_map)->RangeMultiplier(4)->Range(1 << 20, 1 << 24);
+BENCHMARK_TEMPLATE(bm_range_scan, btree_map)->RangeMultiplier(4)->Range(1 << 20, 1 << 24);
+
+BENCHMARK_TEMPLATE(bm_insert_random, std_map)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_insert_random, btree_map)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(bm_load_sorted, std_map)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_load_sorted, btree_map)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <quartz/clock.hpp>
+#include <quartz/histogram.hpp>
+
+#include <chrono>
+
+namespace
+{
+
+void bm_steady_clock_now(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+    }
+}
+
+void bm_tsc_clock_now(benchmark::State &state)
+{
+    qz::tsc_clock::calibrate();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(qz::tsc_clock::now());
+    }
+    state.SetLabel(qz::tsc_clock::uses_tsc() ? "tsc" : "steady_clock fallback");
+}
+
+void bm_tsc_clock_ticks(benchmark::State &state)
+{
+    qz::tsc_clock::calibrate();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(qz::tsc_clock::ticks());
+    }
+}
+
+void bm_histogram_record(benchmark::State &state)
+{
+    qz::latency_histogram histogram;
+    qz::u64 value = 0;
+    for (auto _ : state)
+    {
+        histogram.record(value++ & 0xFFFFU);
+        benchmark::DoNotOptimize(histogram);
+    }
+}
+
+qz::latency_recorder g_recorder; // NOLINT
+
+void bm_recorder_record(benchmark::State &state)
+{
+    qz::u64 value = 0;
+    for (auto _ : state)
+    {
+        g_recorder.record(value++ & 0xFFFFU);
+    }
+}
+
+} // namespace
+
+BENCHMARK(bm_steady_clock_now);
+BENCHMARK(bm_tsc_clock_now);
+BENCHMARK(bm_tsc_clock_ticks);
+BENCHMARK(bm_histogram_record);
+BENCHMARK(bm_recorder_record)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <quartz/epoch.hpp>
+#include <quartz/sync.hpp>
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+namespace
+{
+
+struct routing_table
+{
+    qz::u64 routes[16];
+};
+
+// thread 0 replaces the table every 1024 reads, all other operations are reads.
+constexpr qz::u64 write_interval = 1024;
+
+template <class Lock>
+struct guarded_table
+{
+    Lock lock;
+    alignas(qz::cache_line_size) routing_table table = {};
+};
+
+template <class Lock>
+guarded_table<Lock> g_table; // NOLINT
+
+template <class Lock>
+void bm_locked_read(benchmark::State &state)
+{
+    auto &guarded = g_table<Lock>;
+    qz::u64 iteration = 0;
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0 && ++iteration % write_interval == 0)
+        {
+            std::lock_guard guard(guarded.lock);
+            guarded.table.routes[iteration % 16] = iteration;
+        }
+        else
+        {
+            std::shared_lock guard(guarded.lock);
+            benchmark::DoNotOptimize(guarded.table.routes[iteration % 16]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+qz::rcu_ptr<routing_table> g_rcu_table(std::make_unique<routing_table>()); // NOLINT
+
+void bm_rcu_read(benchmark::State &state)
+{
+    qz::u64 iteration = 0;
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0 && ++iteration % write_interval == 0)
+        {
+            g_rcu_table.update([&](routing_table &table) { table.routes[iteration % 16] = iteration; });
+        }
+        else
+        {
+            const auto table = g_rcu_table.read();
+            benchmark::DoNotOptimize(table->routes[iteration % 16]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+const int g_max_threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2U)); // NOLINT
+
+} // namespace
+
+BENCHMARK(bm_locked_read<std::shared_mutex>)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_locked_read<qz::rw_spinlock>)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_rcu_read)->ThreadRange(1, g_max_threads)->UseRealTime();
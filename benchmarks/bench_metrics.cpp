@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <quartz/metrics.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+std::atomic<qz::u64> g_shared_count = 0; // NOLINT
+
+// the baseline: every thread increments the same cache line.
+void bm_shared_atomic_increment(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        g_shared_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+qz::counter g_counter("bench_increments_total", "Increments made by the benchmark.", 64); // NOLINT
+
+void bm_counter_increment(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        g_counter.increment();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void bm_counter_value(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(g_counter.value());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void bm_registry_write(benchmark::State &state)
+{
+    const auto metric_count = static_cast<qz::usz>(state.range(0));
+    std::vector<std::string> names;
+    names.reserve(metric_count);
+    qz::metric_registry registry;
+    std::vector<std::unique_ptr<qz::counter>> counters;
+    for (qz::usz i = 0; i < metric_count; ++i)
+    {
+        names.push_back("requests_" + std::to_string(i) + "_total");
+        counters.push_back(std::make_unique<qz::counter>(names.back(), "Requests handled by an endpoint."));
+        counters.back()->increment(i * 1000);
+        registry.add(*counters.back());
+    }
+
+    std::vector<char> buffer(metric_count * 256);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(registry.write(buffer.data(), buffer.data() + buffer.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+const int g_max_threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2U)); // NOLINT
+
+} // namespace
+
+BENCHMARK(bm_shared_atomic_increment)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_counter_increment)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_counter_value);
+BENCHMARK(bm_registry_write)->Arg(16)->Arg(256);
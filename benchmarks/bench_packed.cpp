@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+#include <quartz/array.hpp>
+#include <quartz/delta_array.hpp>
+#include <quartz/packed_array.hpp>
+#include <quartz/random.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// 4M values, so that the u64 columns (32 MB) do not fit in cache and scans are memory bound.
+constexpr qz::usz value_count = qz::usz{1} << 22;
+constexpr qz::usz chunk_size  = 1024;
+
+// nanosecond timestamps at a steady rate with some jitter.
+const std::vector<qz::u64> &timestamps()
+{
+    static const auto values = [] {
+        qz::xoshiro256pp engine(42);
+        std::vector<qz::u64> result(value_count);
+        qz::u64 time = 1'700'000'000'000'000'000ULL;
+        for (auto &value : result)
+        {
+            time += 1000 + qz::uniform_int(engine, 64);
+            value = time;
+        }
+        return result;
+    }();
+    return values;
+}
+
+// IDs which fit in 20 bits.
+const std::vector<qz::u64> &small_ids()
+{
+    static const auto values = [] {
+        qz::xoshiro256pp engine(42);
+        std::vector<qz::u64> result(value_count);
+        for (auto &value : result)
+        {
+            value = qz::uniform_int(engine, qz::u64{1} << 20);
+        }
+        return result;
+    }();
+    return values;
+}
+
+void set_counters(benchmark::State &state, qz::usz bytes)
+{
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(value_count));
+    state.counters["bytes_per_value"] = static_cast<double>(bytes) / static_cast<double>(value_count);
+}
+
+void bm_scan_vector(benchmark::State &state)
+{
+    const auto &values = timestamps();
+    for (auto _ : state)
+    {
+        qz::u64 sum = 0;
+        for (const auto value : values)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state, values.size() * sizeof(qz::u64));
+}
+
+void bm_scan_array(benchmark::State &state)
+{
+    auto values = std::make_unique<qz::array<qz::u64, value_count>>();
+    std::copy(timestamps().begin(), timestamps().end(), values->begin());
+    for (auto _ : state)
+    {
+        qz::u64 sum = 0;
+        for (const auto value : *values)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state, sizeof(*values));
+}
+
+void bm_scan_delta_array(benchmark::State &state)
+{
+    const qz::delta_array<qz::u64> values(timestamps());
+    qz::u64 chunk[chunk_size];
+    for (auto _ : state)
+    {
+        qz::u64 sum = 0;
+        for (qz::usz position = 0; position < values.size(); position += chunk_size)
+        {
+            values.decode(position, chunk);
+            for (const auto value : chunk)
+            {
+                sum += value;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state, values.size_bytes());
+}
+
+void bm_scan_ids_vector(benchmark::State &state)
+{
+    const auto &values = small_ids();
+    for (auto _ : state)
+    {
+        qz::u64 sum = 0;
+        for (const auto value : values)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state, values.size() * sizeof(qz::u64));
+}
+
+void bm_scan_ids_packed_array(benchmark::State &state)
+{
+    qz::packed_array<20> values(value_count);
+    for (qz::usz i = 0; i < value_count; ++i)
+    {
+        values.set(i, static_cast<qz::u32>(small_ids()[i]));
+    }
+    qz::u32 chunk[chunk_size];
+    for (auto _ : state)
+    {
+        qz::u64 sum = 0;
+        for (qz::usz position = 0; position < values.size(); position += chunk_size)
+        {
+            values.decode(position, chunk);
+            for (const auto value : chunk)
+            {
+                sum += value;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_counters(state, values.size_bytes());
+}
+
+void bm_random_get_vector(benchmark::State &state)
+{
+    const auto &values = small_ids();
+    qz::xoshiro256pp engine(7);
+    qz::u64 sum = 0;
+    for (auto _ : state)
+    {
+        sum += values[qz::uniform_int(engine, value_count)];
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+void bm_random_get_packed_array(benchmark::State &state)
+{
+    qz::packed_array<20> values(value_count);
+    for (qz::usz i = 0; i < value_count; ++i)
+    {
+        values.set(i, static_cast<qz::u32>(small_ids()[i]));
+    }
+    qz::xoshiro256pp engine(7);
+    qz::u64 sum = 0;
+    for (auto _ : state)
+    {
+        sum += values.get(qz::uniform_int(engine, value_count));
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+} // namespace
+
+BENCHMARK(bm_scan_vector);
+BENCHMARK(bm_scan_array);
+BENCHMARK(bm_scan_delta_array);
+
+BENCHMARK(bm_scan_ids_vector);
+BENCHMARK(bm_scan_ids_packed_array);
+
+BENCHMARK(bm_random_get_vector);
+BENCHMARK(bm_random_get_packed_array);
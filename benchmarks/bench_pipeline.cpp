@@ -0,0 +1,178 @@
+#include <benchmark/benchmark.h>
+#include <quartz/coroutine.hpp>
+#include <quartz/pipeline.hpp>
+
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace
+{
+
+constexpr qz::s64 item_count = 1 << 20;
+
+// every stage does a trivial amount of work per item, so that the cost of passing items between stages dominates.
+qz::generator<qz::s64> source(qz::s64 count)
+{
+    for (qz::s64 i = 0; i < count; ++i)
+    {
+        co_yield i;
+    }
+}
+
+qz::generator<qz::s64> filter_stage(qz::frame_arena & /* unused */, std::span<const qz::s64> batch)
+{
+    for (const auto value : batch)
+    {
+        if (value % 3 != 0)
+        {
+            co_yield value;
+        }
+    }
+}
+
+qz::generator<qz::s64> square_stage(qz::frame_arena & /* unused */, std::span<const qz::s64> batch)
+{
+    for (const auto value : batch)
+    {
+        co_yield value * value;
+    }
+}
+
+void bm_pipeline(benchmark::State &state)
+{
+    const auto batch_size = static_cast<qz::usz>(state.range(0));
+    for (auto _ : state)
+    {
+        qz::s64 sum = 0;
+        qz::pipeline(source(item_count), batch_size)
+            .then(filter_stage)
+            .then(square_stage)
+            .run([&](std::span<const qz::s64> batch) {
+                for (const auto value : batch)
+                {
+                    sum += value;
+                }
+            });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * item_count);
+}
+
+qz::generator<std::span<const qz::s64>> source_chunks(qz::s64 count, qz::usz chunk_size)
+{
+    std::vector<qz::s64> chunk;
+    for (qz::s64 i = 0; i < count;)
+    {
+        chunk.clear();
+        for (; i < count && chunk.size() < chunk_size; ++i)
+        {
+            chunk.push_back(i);
+        }
+        co_yield chunk;
+    }
+}
+
+// the same source and stages yielding whole batches at once, so that every coroutine resumes once per batch.
+void bm_pipeline_spans(benchmark::State &state)
+{
+    const auto batch_size = static_cast<qz::usz>(state.range(0));
+    for (auto _ : state)
+    {
+        qz::s64 sum = 0;
+        qz::pipeline(source_chunks(item_count, batch_size), batch_size)
+            .then([buffer = std::vector<qz::s64>()](
+                      std::span<const qz::s64> batch) mutable -> qz::generator<std::span<const qz::s64>> {
+                buffer.clear();
+                for (const auto value : batch)
+                {
+                    if (value % 3 != 0)
+                    {
+                        buffer.push_back(value);
+                    }
+                }
+                co_yield buffer;
+            })
+            .then([buffer = std::vector<qz::s64>()](
+                      std::span<const qz::s64> batch) mutable -> qz::generator<std::span<const qz::s64>> {
+                buffer.clear();
+                for (const auto value : batch)
+                {
+                    buffer.push_back(value * value);
+                }
+                co_yield buffer;
+            })
+            .run([&](std::span<const qz::s64> batch) {
+                for (const auto value : batch)
+                {
+                    sum += value;
+                }
+            });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * item_count);
+}
+
+// the same stages pulling from each other one item at a time.
+qz::generator<qz::s64> filter_each(qz::generator<qz::s64> input)
+{
+    for (const auto value : input)
+    {
+        if (value % 3 != 0)
+        {
+            co_yield value;
+        }
+    }
+}
+
+qz::generator<qz::s64> square_each(qz::generator<qz::s64> input)
+{
+    for (const auto value : input)
+    {
+        co_yield value * value;
+    }
+}
+
+void bm_generator_chain(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        qz::s64 sum = 0;
+        for (const auto value : square_each(filter_each(source(item_count))))
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * item_count);
+}
+
+// the same stages pushing each item to the next through type erased callbacks.
+void bm_callback_pipeline(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        qz::s64 sum = 0;
+        std::function<void(qz::s64)> sink   = [&](qz::s64 value) { sum += value; };
+        std::function<void(qz::s64)> square = [&](qz::s64 value) { sink(value * value); };
+        std::function<void(qz::s64)> filter = [&](qz::s64 value) {
+            if (value % 3 != 0)
+            {
+                square(value);
+            }
+        };
+        for (qz::s64 i = 0; i < item_count; ++i)
+        {
+            filter(i);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * item_count);
+}
+
+} // namespace
+
+BENCHMARK(bm_pipeline)->Arg(1)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_pipeline_spans)->Arg(1)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_generator_chain)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_callback_pipeline)->Unit(benchmark::kMillisecond);
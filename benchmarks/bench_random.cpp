@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <quartz/random.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+template <class Engine>
+void bm_engine(benchmark::State &state)
+{
+    Engine engine(42);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(engine());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Engine>
+void bm_bounded(benchmark::State &state)
+{
+    Engine engine(42);
+    std::uniform_int_distribution<qz::u64> distribution(0, 999);
+    for (auto _ : state)
+    {
+        if constexpr (std::is_same_v<Engine, std::mt19937_64>)
+        {
+            benchmark::DoNotOptimize(distribution(engine));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(qz::uniform_int(engine, 1000));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void bm_fill_scalar(benchmark::State &state)
+{
+    qz::xoshiro256pp engine(42);
+    std::vector<qz::u64> buffer(static_cast<qz::usz>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (auto &value : buffer)
+        {
+            value = engine();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<qz::s64>(sizeof(qz::u64)));
+}
+
+template <qz::usz Lanes>
+void bm_fill_batch(benchmark::State &state)
+{
+    qz::xoshiro256pp_batch<Lanes> engine(42);
+    std::vector<qz::u64> buffer(static_cast<qz::usz>(state.range(0)));
+    for (auto _ : state)
+    {
+        engine.fill(buffer);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<qz::s64>(sizeof(qz::u64)));
+}
+
+} // namespace
+
+BENCHMARK(bm_engine<std::mt19937_64>);
+BENCHMARK(bm_engine<qz::xoshiro256pp>);
+BENCHMARK(bm_engine<qz::pcg64>);
+
+BENCHMARK(bm_bounded<std::mt19937_64>);
+BENCHMARK(bm_bounded<qz::xoshiro256pp>);
+BENCHMARK(bm_bounded<qz::pcg64>);
+
+BENCHMARK(bm_fill_scalar)->Arg(4096);
+BENCHMARK(bm_fill_batch<4>)->Arg(4096);
+BENCHMARK(bm_fill_batch<8>)->Arg(4096);
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+#include <quartz/radix_sort.hpp>
+#include <quartz/random.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if defined(QZ_BENCH_PARALLEL_STL)
+    #include <execution>
+#endif
+
+namespace
+{
+
+template <class T>
+const std::vector<T> &cached_keys(qz::usz count)
+{
+    static std::vector<T> keys;
+    if (keys.size() != count)
+    {
+        qz::xoshiro256pp engine(42);
+        keys.resize(count);
+        for (auto &key : keys)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                key = qz::uniform_real<T>(engine, T{-1e9}, T{1e9});
+            }
+            else
+            {
+                key = static_cast<T>(engine());
+            }
+        }
+    }
+    return keys;
+}
+
+const qz::usz g_max_threads = std::max<qz::usz>(std::thread::hardware_concurrency(), 1); // NOLINT
+
+// every iteration sorts a fresh copy of the same random keys. Copying is excluded from the timing.
+template <class T, class Sort>
+void run_sort(benchmark::State &state, Sort sort)
+{
+    const auto &keys = cached_keys<T>(static_cast<qz::usz>(state.range(0)));
+    std::vector<T> copy(keys.size());
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::copy(keys.begin(), keys.end(), copy.begin());
+        state.ResumeTiming();
+        sort(copy);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class T>
+void bm_std_sort(benchmark::State &state)
+{
+    run_sort<T>(state, [](std::vector<T> &keys) { std::sort(keys.begin(), keys.end()); });
+}
+
+#if defined(QZ_BENCH_PARALLEL_STL)
+template <class T>
+void bm_std_sort_par(benchmark::State &state)
+{
+    run_sort<T>(state, [](std::vector<T> &keys) { std::sort(std::execution::par, keys.begin(), keys.end()); });
+}
+#endif
+
+template <class T>
+void bm_radix_sort(benchmark::State &state)
+{
+    run_sort<T>(state, [](std::vector<T> &keys) { qz::radix_sort(std::span(keys)); });
+}
+
+template <class T>
+void bm_radix_sort_threads(benchmark::State &state)
+{
+    run_sort<T>(state, [](std::vector<T> &keys) { qz::radix_sort(std::span(keys), g_max_threads); });
+}
+
+void bm_radix_sort_indices(benchmark::State &state)
+{
+    const auto &keys = cached_keys<qz::u32>(static_cast<qz::usz>(state.range(0)));
+    std::vector<qz::u32> indices(keys.size());
+    for (auto _ : state)
+    {
+        qz::radix_sort_indices(std::span(keys), std::span(indices));
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_std_sort_indices(benchmark::State &state)
+{
+    const auto &keys = cached_keys<qz::u32>(static_cast<qz::usz>(state.range(0)));
+    std::vector<qz::u32> indices(keys.size());
+    for (auto _ : state)
+    {
+        for (qz::u32 i = 0; i < indices.size(); ++i)
+        {
+            indices[i] = i;
+        }
+        std::stable_sort(indices.begin(), indices.end(), [&](qz::u32 a, qz::u32 b) { return keys[a] < keys[b]; });
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 1M & 16M keys. Sorting 100M+ keys takes the same time per key as 16M, as both are far beyond the caches.
+void sort_sizes(benchmark::internal::Benchmark *bench)
+{
+    bench->RangeMultiplier(16)->Range(1 << 20, 1 << 24)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(bm_std_sort, qz::u32)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_std_sort, qz::u64)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_std_sort, qz::f32)->Apply(sort_sizes);
+#if defined(QZ_BENCH_PARALLEL_STL)
+BENCHMARK_TEMPLATE(bm_std_sort_par, qz::u32)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_std_sort_par, qz::u64)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_std_sort_par, qz::f32)->Apply(sort_sizes);
+#endif
+BENCHMARK_TEMPLATE(bm_radix_sort, qz::u32)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_radix_sort, qz::u64)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_radix_sort, qz::f32)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_radix_sort_threads, qz::u32)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_radix_sort_threads, qz::u64)->Apply(sort_sizes);
+BENCHMARK_TEMPLATE(bm_radix_sort_threads, qz::f32)->Apply(sort_sizes);
+
+BENCHMARK(bm_std_sort_indices)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_radix_sort_indices)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
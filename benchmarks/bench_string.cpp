@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+#include <quartz/format.hpp>
+#include <quartz/random.hpp>
+#include <quartz/string.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// integers with a uniformly distributed number of digits, so that no digit count dominates.
+std::vector<qz::u64> make_integers()
+{
+    qz::xoshiro256pp engine(42);
+    std::vector<qz::u64> values(1024);
+    for (auto &value : values)
+    {
+        value = engine() >> qz::uniform_int(engine, 64);
+    }
+    return values;
+}
+
+std::vector<qz::f64> make_floats()
+{
+    qz::xoshiro256pp engine(42);
+    std::vector<qz::f64> values(1024);
+    for (auto &value : values)
+    {
+        value = qz::uniform_real<qz::f64>(engine, -1e6, 1e6);
+    }
+    return values;
+}
+
+void bm_format_int_snprintf(benchmark::State &state)
+{
+    const auto values = make_integers();
+    char buffer[32];
+    for (auto _ : state)
+    {
+        for (const auto value : values)
+        {
+            benchmark::DoNotOptimize(std::snprintf(buffer, sizeof(buffer), "%llu", value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(values.size()));
+}
+
+void bm_format_int_to_string(benchmark::State &state)
+{
+    const auto values = make_integers();
+    for (auto _ : state)
+    {
+        for (const auto value : values)
+        {
+            benchmark::DoNotOptimize(std::to_string(value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(values.size()));
+}
+
+void bm_format_int_qz(benchmark::State &state)
+{
+    const auto values = make_integers();
+    char buffer[qz::max_formatted_size<qz::u64>];
+    for (auto _ : state)
+    {
+        for (const auto value : values)
+        {
+            benchmark::DoNotOptimize(qz::format_to(buffer, buffer + sizeof(buffer), value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(values.size()));
+}
+
+void bm_format_float_snprintf(benchmark::State &state)
+{
+    const auto values = make_floats();
+    char buffer[32];
+    for (auto _ : state)
+    {
+        for (const auto value : values)
+        {
+            benchmark::DoNotOptimize(std::snprintf(buffer, sizeof(buffer), "%.17g", value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(values.size()));
+}
+
+void bm_format_float_qz(benchmark::State &state)
+{
+    const auto values = make_floats();
+    char buffer[qz::max_formatted_size<qz::f64>];
+    for (auto _ : state)
+    {
+        for (const auto value : values)
+        {
+            benchmark::DoNotOptimize(qz::format_to(buffer, buffer + sizeof(buffer), value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<qz::s64>(values.size()));
+}
+
+// builds keys of the given length, e.g. for a map of metric names.
+template <class String>
+void bm_string_build(benchmark::State &state)
+{
+    const auto length = static_cast<qz::usz>(state.range(0));
+    const std::string key(length, 'k');
+    for (auto _ : state)
+    {
+        String string(key.c_str());
+        benchmark::DoNotOptimize(string.data());
+    }
+}
+
+} // namespace
+
+BENCHMARK(bm_format_int_snprintf);
+BENCHMARK(bm_format_int_to_string);
+BENCHMARK(bm_format_int_qz);
+
+BENCHMARK(bm_format_float_snprintf);
+BENCHMARK(bm_format_float_qz);
+
+BENCHMARK(bm_string_build<std::string>)->Arg(8)->Arg(20)->Arg(64);
+BENCHMARK(bm_string_build<qz::small_string>)->Arg(8)->Arg(20)->Arg(64);
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include <quartz/sync.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+namespace
+{
+
+// the guarded data is kept on a separate cache line from the lock, so the benchmark measures lock traffic only.
+template <class Lock>
+struct guarded_counter
+{
+    Lock lock;
+    alignas(qz::cache_line_size) qz::u64 value = 0;
+};
+
+template <class Lock>
+guarded_counter<Lock> g_counter; // NOLINT
+
+template <class Lock>
+void bm_exclusive(benchmark::State &state)
+{
+    auto &counter = g_counter<Lock>;
+    for (auto _ : state)
+    {
+        std::lock_guard guard(counter.lock);
+        benchmark::DoNotOptimize(++counter.value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// every 16th operation is a write, the rest are reads.
+template <class Lock>
+void bm_read_mostly(benchmark::State &state)
+{
+    auto &counter = g_counter<Lock>;
+    qz::u64 iteration = 0;
+    for (auto _ : state)
+    {
+        if ((++iteration & 15U) == 0)
+        {
+            std::lock_guard guard(counter.lock);
+            benchmark::DoNotOptimize(++counter.value);
+        }
+        else
+        {
+            std::shared_lock guard(counter.lock);
+            benchmark::DoNotOptimize(counter.value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+struct seqlock_snapshot
+{
+    qz::u64 values[4];
+};
+
+qz::seqlock<seqlock_snapshot> g_seqlock; // NOLINT
+
+void bm_seqlock_read_mostly(benchmark::State &state)
+{
+    qz::u64 iteration = 0;
+    for (auto _ : state)
+    {
+        if ((++iteration & 15U) == 0)
+        {
+            g_seqlock.store({{iteration, iteration, iteration, iteration}});
+        }
+        else
+        {
+            benchmark::DoNotOptimize(g_seqlock.load());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+const int g_max_threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 2U)); // NOLINT
+
+} // namespace
+
+BENCHMARK(bm_exclusive<std::mutex>)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_exclusive<qz::spinlock>)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_exclusive<qz::mutex>)->ThreadRange(1, g_max_threads)->UseRealTime();
+
+BENCHMARK(bm_read_mostly<std::shared_mutex>)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_read_mostly<qz::rw_spinlock>)->ThreadRange(1, g_max_threads)->UseRealTime();
+BENCHMARK(bm_seqlock_read_mostly)->ThreadRange(1, g_max_threads)->UseRealTime();
@@ -7,6 +7,26 @@
 
 #include "quartz/array.hpp"
 #include "quartz/assert.hpp"
+#include "quartz/btree.hpp"
+#include "quartz/clock.hpp"
+#include "quartz/coroutine.hpp"
+#include "quartz/delta_array.hpp"
+#include "quartz/epoch.hpp"
+#include "quartz/expected.hpp"
+#include "quartz/format.hpp"
+#include "quartz/hardware.hpp"
+#include "quartz/histogram.hpp"
+#include "quartz/intrusive_hash_table.hpp"
+#include "quartz/intrusive_list.hpp"
 #include "quartz/macros.hpp"
+#include "quartz/metrics.hpp"
+#include "quartz/optional.hpp"
+#include "quartz/packed_array.hpp"
+#include "quartz/pipeline.hpp"
+#include "quartz/radix_sort.hpp"
+#include "quartz/random.hpp"
+#include "quartz/slot_map.hpp"
+#include "quartz/string.hpp"
+#include "quartz/sync.hpp"
 #include "quartz/types.hpp"
 #include "quartz/utilities.hpp"
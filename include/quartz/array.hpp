@@ -2,11 +2,17 @@
 
 #include <cstddef>
 #include <iterator>
-#include <stdexcept>
 
+#include "quartz/assert.hpp"
+#include "quartz/macros.hpp"
+#include "quartz/optional.hpp"
 #include "quartz/types.hpp"
 #include "quartz/utilities.hpp"
 
+#if !defined(QZ_NO_EXCEPTIONS)
+    #include <stdexcept>
+#endif
+
 ///
 /// @defgroup QzContainers ADT Containers
 /// @brief A collection of abstract data type containers.
@@ -60,27 +66,43 @@ struct array
     }
 
     /// @brief Get a reference to the element at the given position.
-    /// @param pos The position of the element. If out of bounds, throws an exception.
+    /// @param pos The position of the element. If out of bounds, throws an exception (or reports an assertion
+    /// failure when built with QZ_NO_EXCEPTIONS).
     [[nodiscard]] constexpr reference at(size_type pos)
     {
         if (pos >= N)
         {
-            throw std::out_of_range("Index out of bounds access.");
+            QZ_THROW(std::out_of_range, "Index out of bounds access.");
         }
         return m_data[pos];
     }
 
     /// @brief Get a const reference to the element at the given position.
-    /// @param pos The position of the element. If out of bounds, throws an exception.
+    /// @param pos The position of the element. If out of bounds, throws an exception (or reports an assertion
+    /// failure when built with QZ_NO_EXCEPTIONS).
     [[nodiscard]] constexpr const_reference at(size_type pos) const
     {
         if (pos >= N)
         {
-            throw std::out_of_range("Index out of bounds access.");
+            QZ_THROW(std::out_of_range, "Index out of bounds access.");
         }
         return m_data[pos];
     }
 
+    /// @brief Get an optional reference to the element at the given position.
+    /// @param pos The position of the element. If out of bounds, an empty optional is returned.
+    [[nodiscard]] constexpr optional<reference> try_at(size_type pos)
+    {
+        return pos < N ? optional<reference>(m_data[pos]) : nullopt;
+    }
+
+    /// @brief Get an optional const reference to the element at the given position.
+    /// @param pos The position of the element. If out of bounds, an empty optional is returned.
+    [[nodiscard]] constexpr optional<const_reference> try_at(size_type pos) const
+    {
+        return pos < N ? optional<const_reference>(m_data[pos]) : nullopt;
+    }
+
     /// @brief Get a reference to the first element.
     [[nodiscard]] constexpr reference front()
     {
@@ -274,12 +296,22 @@ struct array<T, 0>
 
     [[nodiscard]] constexpr reference at([[maybe_unused]] size_type pos)
     {
-        throw std::out_of_range("Index out of bounds access.");
+        QZ_THROW(std::out_of_range, "Index out of bounds access.");
     }
 
     [[nodiscard]] constexpr const_reference at([[maybe_unused]] size_type pos) const
     {
-        throw std::out_of_range("Index out of bounds access.");
+        QZ_THROW(std::out_of_range, "Index out of bounds access.");
+    }
+
+    [[nodiscard]] constexpr optional<reference> try_at([[maybe_unused]] size_type pos)
+    {
+        return nullopt;
+    }
+
+    [[nodiscard]] constexpr optional<const_reference> try_at([[maybe_unused]] size_type pos) const
+    {
+        return nullopt;
     }
 
     [[nodiscard]] constexpr reference front()
@@ -118,3 +118,17 @@ void handle_assertion_failure(const assertion_failure_context &context);
 ///
 #define QZ_VERIFY_MSG(cnd, msg)                                                                                        \
     ((cnd) ? static_cast<void>(0) : qz::handle_assertion_failure({QZ_STRINGIFY(cnd), msg, QZ_FILE, QZ_FUNC, QZ_LINE}))
+
+#if defined(QZ_NO_EXCEPTIONS)
+    ///
+    /// @ingroup QzAssert
+    ///
+    /// @brief Throw an exception of the given type, constructed from the message. When exceptions are disabled (see
+    /// QZ_NO_EXCEPTIONS), report the failure through the assertion handler and terminate instead.
+    /// @param type The exception type.
+    /// @param msg The message describing the failure.
+    ///
+    #define QZ_THROW(type, msg) qz::handle_assertion_failure({QZ_STRINGIFY(type), msg, QZ_FILE, QZ_FUNC, QZ_LINE})
+#else
+    #define QZ_THROW(type, msg) throw type(msg)
+#endif
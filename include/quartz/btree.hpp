@@ -0,0 +1,1138 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "quartz/array.hpp"
+#include "quartz/assert.hpp"
+#include "quartz/hardware.hpp"
+#include "quartz/optional.hpp"
+#include "quartz/types.hpp"
+#include "quartz/utilities.hpp"
+
+#if !defined(QZ_NO_EXCEPTIONS)
+    #include <stdexcept>
+#endif
+
+namespace qz
+{
+
+/// @cond Undocumented
+namespace detail
+{
+
+// stands in for the values of a btree_set, which has none.
+struct btree_no_values
+{
+};
+
+// keys per node: enough to fill four cache lines, but at least 8 so that large keys still get a useful fanout.
+template <class Key>
+inline constexpr usz btree_node_keys = std::max<usz>(8, 4 * cache_line_size / sizeof(Key));
+
+// keys ordered by the built-in less-than are searched with a fixed length counting loop, which the compiler turns
+// into a handful of SIMD compares. Other keys use a branch free binary search.
+template <class Key, class Compare>
+inline constexpr bool btree_linear_search =
+    std::is_arithmetic_v<Key> && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>);
+
+// returned from operator-> of iterators which dereference to a proxy pair.
+template <class Reference>
+struct btree_arrow_proxy
+{
+    Reference reference;
+
+    constexpr const Reference *operator->() const
+    {
+        return &reference;
+    }
+};
+
+} // namespace detail
+/// @endcond
+
+///
+/// @ingroup QzContainers
+///
+/// @brief An ordered associative container implemented as a B+ tree with wide, cache line sized nodes.
+/// @details Each node holds its keys contiguously in a qz::array spanning four cache lines, so a lookup touches one
+/// or two lines per level of a tree which is only a handful of levels deep, instead of one line per level of a
+/// red-black tree. The position within a node is found without branching on the comparisons. Values live only in the
+/// leaves, next to but separate from the keys, and the leaves are linked in both directions so that iterating over a
+/// range is a walk over arrays.
+///
+/// Unlike std::map, keys and values are moved around on insertion and erasure, which invalidates all iterators and
+/// references into the container. Keys and values must be default constructible and move assignable.
+///
+/// @tparam Key The key type.
+/// @tparam T The mapped type, or void for a set of keys.
+/// @tparam Compare The strict weak ordering of the keys.
+///
+template <class Key, class T, class Compare = std::less<Key>>
+class basic_btree
+{
+    static_assert(std::is_default_constructible_v<Key> && std::is_move_assignable_v<Key>,
+                  "B-tree keys must be default constructible and move assignable.");
+
+    static constexpr bool is_map = !std::is_void_v<T>;
+    using mapped_storage         = std::conditional_t<is_map, T, detail::btree_no_values>;
+
+    template <bool Const>
+    class basic_iterator;
+
+  public:
+    // TYPEDEFS
+
+    using key_type        = Key;
+    using mapped_type     = T;
+    using value_type      = std::conditional_t<is_map, std::pair<Key, mapped_storage>, Key>;
+    using size_type       = usz;
+    using difference_type = ssz;
+    using key_compare     = Compare;
+    /// @brief A pair of references to the key and the value for maps, which do not store pairs, else a key reference.
+    using reference       = std::conditional_t<is_map, std::pair<const Key &, mapped_storage &>, const Key &>;
+    using const_reference = std::conditional_t<is_map, std::pair<const Key &, const mapped_storage &>, const Key &>;
+    using iterator        = basic_iterator<false>;
+    using const_iterator  = basic_iterator<true>;
+
+    /// @brief The maximum number of keys stored in a node.
+    static constexpr size_type node_capacity = detail::btree_node_keys<Key>;
+
+    // CONSTRUCTORS
+
+    constexpr basic_btree() = default;
+
+    /// @brief Construct an empty tree using the given comparison.
+    constexpr explicit basic_btree(const Compare &compare) : m_compare(compare)
+    {
+    }
+
+    /// @brief Construct a tree holding the given values, which need not be sorted. Later duplicates are ignored.
+    basic_btree(std::initializer_list<value_type> values)
+    {
+        for (const auto &value : values)
+        {
+            insert(value);
+        }
+    }
+
+    basic_btree(const basic_btree &other) : m_compare(other.m_compare)
+    {
+        bulk_load(other.begin(), other.end());
+    }
+
+    basic_btree(basic_btree &&other) noexcept
+        : m_root(other.m_root), m_first(other.m_first), m_last(other.m_last), m_size(other.m_size),
+          m_compare(qz::move(other.m_compare))
+    {
+        other.m_root  = nullptr;
+        other.m_first = nullptr;
+        other.m_last  = nullptr;
+        other.m_size  = 0;
+    }
+
+    ~basic_btree()
+    {
+        clear();
+    }
+
+    // METHODS
+
+    /// @brief Replace the contents of the tree with a sequence sorted by key, building it bottom up in linear time.
+    /// @details Leaves are filled completely from left to right, then each level of inner nodes is built over the one
+    /// below it. Only the last node of each level may need topping up from its neighbour. Compared to inserting the
+    /// keys one at a time, this takes a fraction of the time and leaves no half empty nodes.
+    /// @param first The start of the sequence. For maps, elements must have `first` and `second` members, as the
+    /// references of this container do.
+    /// @param last The end of the sequence. Keys equal to the previous key are ignored. Checked to be sorted in debug
+    /// builds.
+    template <class Iterator, class Sentinel>
+    void bulk_load(Iterator first, Sentinel last)
+    {
+        clear();
+
+        std::vector<node *> level;
+        for (; first != last; ++first)
+        {
+            decltype(auto) element = *first;
+            const auto &key        = element_key(element);
+            if (m_last != nullptr)
+            {
+                const auto &previous = m_last->keys[m_last->size - 1];
+                QZ_ASSERT_MSG(!m_compare(key, previous), "Bulk loaded keys must be sorted.");
+                if (!m_compare(previous, key))
+                {
+                    continue;
+                }
+            }
+
+            if (m_last == nullptr || m_last->size == node_capacity)
+            {
+                auto *leaf = new leaf_node();
+                link_after(m_last, leaf);
+                level.push_back(leaf);
+            }
+            m_last->keys[m_last->size] = key;
+            if constexpr (is_map)
+            {
+                m_last->values[m_last->size] = element.second;
+            }
+            ++m_last->size;
+            ++m_size;
+        }
+
+        if (level.empty())
+        {
+            return;
+        }
+        if (level.size() > 1 && m_last->size < min_keys)
+        {
+            even_out_leaves(m_last->prev, m_last);
+        }
+
+        while (level.size() > 1)
+        {
+            std::vector<node *> parents;
+            for (size_type i = 0; i < level.size(); i += node_capacity + 1)
+            {
+                const auto count = std::min(node_capacity + 1, level.size() - i);
+                parents.push_back(make_inner(level.data() + i, count));
+            }
+            if (parents.size() > 1 && parents.back()->size < min_keys)
+            {
+                even_out_inners(static_cast<inner_node *>(parents[parents.size() - 2]),
+                                static_cast<inner_node *>(parents.back()));
+            }
+            level = qz::move(parents);
+        }
+        m_root = level[0];
+    }
+
+    /// @brief Insert a key into a set, unless an equal key is already present.
+    /// @return The position of the key with the given value, and true if it was inserted.
+    template <class K = Key>
+        requires(!is_map && std::is_constructible_v<Key, K &&>)
+    std::pair<iterator, bool> insert(K &&key)
+    {
+        return emplace_unique(static_cast<K &&>(key));
+    }
+
+    /// @brief Insert a key and value pair into a map, unless an equal key is already present.
+    /// @return The position of the element with the given key, and true if it was inserted.
+    std::pair<iterator, bool> insert(const value_type &value)
+        requires(is_map)
+    {
+        return emplace_unique(value.first, value.second);
+    }
+
+    /// @brief Insert a key into a map along with a value constructed from the given arguments, unless an equal key is
+    /// already present. The arguments are left untouched in that case.
+    /// @return The position of the element with the given key, and true if it was inserted.
+    template <class K, class... Args>
+        requires(is_map)
+    std::pair<iterator, bool> try_emplace(K &&key, Args &&...args)
+    {
+        return emplace_unique(static_cast<K &&>(key), static_cast<Args &&>(args)...);
+    }
+
+    /// @brief Insert a key and value into a map, or assign the value if an equal key is already present.
+    /// @return The position of the element with the given key, and true if it was inserted.
+    template <class K, class V>
+        requires(is_map)
+    std::pair<iterator, bool> insert_or_assign(K &&key, V &&value)
+    {
+        auto result = emplace_unique(static_cast<K &&>(key));
+        result.first.value() = static_cast<V &&>(value);
+        return result;
+    }
+
+    /// @brief Erase the element with the given key, if there is one.
+    /// @details A leaf left less than half full borrows from a sibling which can spare a key, or else is merged into
+    /// it, after which the same may repeat for its parent.
+    /// @return The number of elements erased, which is either zero or one.
+    size_type erase(const Key &key)
+    {
+        if (m_root == nullptr)
+        {
+            return 0;
+        }
+
+        path_type path;
+        auto *leaf       = descend(key, path);
+        const auto index = lower_index(leaf->keys.data(), leaf->size, key);
+        if (index == leaf->size || m_compare(key, leaf->keys[index]))
+        {
+            return 0;
+        }
+
+        erase_from_leaf(leaf, index);
+        --m_size;
+
+        if (path.depth == 0)
+        {
+            if (leaf->size == 0)
+            {
+                delete leaf;
+                m_root  = nullptr;
+                m_first = nullptr;
+                m_last  = nullptr;
+            }
+            return 1;
+        }
+
+        if (leaf->size < min_keys)
+        {
+            rebalance_leaf(leaf, path.nodes[path.depth - 1], path.slots[path.depth - 1]);
+            for (auto depth = path.depth - 1; depth > 0 && path.nodes[depth]->size < min_keys; --depth)
+            {
+                rebalance_inner(path.nodes[depth], path.nodes[depth - 1], path.slots[depth - 1]);
+            }
+            if (!m_root->leaf && m_root->size == 0)
+            {
+                auto *root = static_cast<inner_node *>(m_root);
+                m_root     = root->children[0];
+                delete root;
+            }
+        }
+        return 1;
+    }
+
+    /// @brief Erase the element at the given position.
+    /// @return The position of the element following the erased one.
+    iterator erase(const_iterator pos)
+    {
+        QZ_ASSERT_MSG(pos != end(), "Cannot erase the end iterator.");
+        auto key = pos.key();
+        erase(key);
+        return lower_bound(key);
+    }
+
+    /// @brief Erase all elements from the tree.
+    void clear()
+    {
+        if (m_root != nullptr)
+        {
+            destroy(m_root);
+        }
+        m_root  = nullptr;
+        m_first = nullptr;
+        m_last  = nullptr;
+        m_size  = 0;
+    }
+
+    /// @brief Swap the contents of this tree with those of the other tree.
+    void swap(basic_btree &other) noexcept
+    {
+        qz::swap(m_root, other.m_root);
+        qz::swap(m_first, other.m_first);
+        qz::swap(m_last, other.m_last);
+        qz::swap(m_size, other.m_size);
+        qz::swap(m_compare, other.m_compare);
+    }
+
+    /// @brief Get the position of the element with the given key, or end() if there is none.
+    [[nodiscard]] iterator find(const Key &key)
+    {
+        auto it = lower_bound(key);
+        return it != end() && !m_compare(key, it.key()) ? it : end();
+    }
+
+    /// @brief Get the position of the element with the given key, or end() if there is none.
+    [[nodiscard]] const_iterator find(const Key &key) const
+    {
+        return const_cast<basic_btree *>(this)->find(key);
+    }
+
+    /// @brief True if the tree holds an element with the given key, else false.
+    [[nodiscard]] bool contains(const Key &key) const
+    {
+        return find(key) != end();
+    }
+
+    /// @brief Get the number of elements with the given key, which is either zero or one.
+    [[nodiscard]] size_type count(const Key &key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /// @brief Get the position of the first element whose key is not less than the given key.
+    [[nodiscard]] iterator lower_bound(const Key &key)
+    {
+        if (m_root == nullptr)
+        {
+            return end();
+        }
+        path_type path;
+        auto *leaf = descend(key, path);
+        return make_iterator(leaf, lower_index(leaf->keys.data(), leaf->size, key));
+    }
+
+    /// @brief Get the position of the first element whose key is not less than the given key.
+    [[nodiscard]] const_iterator lower_bound(const Key &key) const
+    {
+        return const_cast<basic_btree *>(this)->lower_bound(key);
+    }
+
+    /// @brief Get the position of the first element whose key is greater than the given key.
+    [[nodiscard]] iterator upper_bound(const Key &key)
+    {
+        if (m_root == nullptr)
+        {
+            return end();
+        }
+        path_type path;
+        auto *leaf = descend(key, path);
+        return make_iterator(leaf, upper_index(leaf->keys.data(), leaf->size, key));
+    }
+
+    /// @brief Get the position of the first element whose key is greater than the given key.
+    [[nodiscard]] const_iterator upper_bound(const Key &key) const
+    {
+        return const_cast<basic_btree *>(this)->upper_bound(key);
+    }
+
+    /// @brief Get a reference to the value mapped to the given key. If there is none, throws an exception (or
+    /// reports an assertion failure when built with QZ_NO_EXCEPTIONS).
+    [[nodiscard]] mapped_storage &at(const Key &key)
+        requires(is_map)
+    {
+        auto it = find(key);
+        if (it == end())
+        {
+            QZ_THROW(std::out_of_range, "Key not found in B-tree.");
+        }
+        return it.value();
+    }
+
+    /// @brief Get a const reference to the value mapped to the given key. If there is none, throws an exception (or
+    /// reports an assertion failure when built with QZ_NO_EXCEPTIONS).
+    [[nodiscard]] const mapped_storage &at(const Key &key) const
+        requires(is_map)
+    {
+        return const_cast<basic_btree *>(this)->at(key);
+    }
+
+    /// @brief Get an optional reference to the value mapped to the given key, which is empty if there is none.
+    [[nodiscard]] optional<mapped_storage &> try_at(const Key &key)
+        requires(is_map)
+    {
+        auto it = find(key);
+        return it != end() ? optional<mapped_storage &>(it.value()) : nullopt;
+    }
+
+    /// @brief Get an optional const reference to the value mapped to the given key, which is empty if there is none.
+    [[nodiscard]] optional<const mapped_storage &> try_at(const Key &key) const
+        requires(is_map)
+    {
+        auto it = find(key);
+        return it != end() ? optional<const mapped_storage &>(it.value()) : nullopt;
+    }
+
+    /// @brief Get the number of elements in the tree.
+    [[nodiscard]] size_type size() const
+    {
+        return m_size;
+    }
+
+    /// @brief True if the tree holds no elements, else false.
+    [[nodiscard]] bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// @brief Get the number of levels in the tree, which is zero for an empty tree.
+    [[nodiscard]] size_type height() const
+    {
+        if (m_root == nullptr)
+        {
+            return 0;
+        }
+        size_type height = 1;
+        for (const auto *n = m_root; !n->leaf; n = static_cast<const inner_node *>(n)->children[0])
+        {
+            ++height;
+        }
+        return height;
+    }
+
+    [[nodiscard]] iterator begin()
+    {
+        return iterator(m_first, 0);
+    }
+
+    [[nodiscard]] const_iterator begin() const
+    {
+        return const_iterator(m_first, 0);
+    }
+
+    [[nodiscard]] iterator end()
+    {
+        return m_last != nullptr ? iterator(m_last, m_last->size) : iterator();
+    }
+
+    [[nodiscard]] const_iterator end() const
+    {
+        return m_last != nullptr ? const_iterator(m_last, m_last->size) : const_iterator();
+    }
+
+    // OPERATOR OVERLOADS
+
+    basic_btree &operator=(const basic_btree &other)
+    {
+        if (this != &other)
+        {
+            basic_btree copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    basic_btree &operator=(basic_btree &&other) noexcept
+    {
+        basic_btree moved(qz::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    /// @brief Get a reference to the value mapped to the given key, inserting a default constructed value if there is
+    /// none.
+    mapped_storage &operator[](const Key &key)
+        requires(is_map)
+    {
+        return emplace_unique(key).first.value();
+    }
+
+  private:
+    struct node
+    {
+        u32 size  = 0;
+        bool leaf = true;
+    };
+
+    struct leaf_node : node
+    {
+        leaf_node *prev = nullptr;
+        leaf_node *next = nullptr;
+        array<Key, node_capacity> keys{};
+        [[no_unique_address]] std::conditional_t<is_map, array<mapped_storage, node_capacity>,
+                                                 detail::btree_no_values> values{};
+    };
+
+    // child i holds the keys k with keys[i - 1] <= k < keys[i].
+    struct inner_node : node
+    {
+        inner_node()
+        {
+            this->leaf = false;
+        }
+
+        array<Key, node_capacity> keys{};
+        array<node *, node_capacity + 1> children{};
+    };
+
+    // the inner nodes visited on the way down to a leaf, along with the index of the child taken from each. Every
+    // inner node has at least five children, so 32 levels are more than enough for any tree which fits in memory.
+    struct path_type
+    {
+        array<inner_node *, 32> nodes;
+        array<u32, 32> slots;
+        u32 depth = 0;
+    };
+
+    static constexpr size_type min_keys = node_capacity / 2;
+
+    template <bool Const>
+    class basic_iterator
+    {
+      public:
+        using iterator_concept  = std::bidirectional_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = typename basic_btree::value_type;
+        using difference_type   = ssz;
+        using reference =
+            std::conditional_t<Const, typename basic_btree::const_reference, typename basic_btree::reference>;
+
+        constexpr basic_iterator() = default;
+
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        constexpr basic_iterator(const basic_iterator<OtherConst> &other) // NOLINT (implicit conversion)
+            : m_leaf(other.m_leaf), m_index(other.m_index)
+        {
+        }
+
+        /// @brief Get the key of the element.
+        [[nodiscard]] constexpr const Key &key() const
+        {
+            return m_leaf->keys[m_index];
+        }
+
+        /// @brief Get the value of the element. Only available for maps.
+        [[nodiscard]] constexpr auto &value() const
+            requires(is_map)
+        {
+            if constexpr (Const)
+            {
+                return static_cast<const mapped_storage &>(m_leaf->values[m_index]);
+            }
+            else
+            {
+                return m_leaf->values[m_index];
+            }
+        }
+
+        [[nodiscard]] constexpr reference operator*() const
+        {
+            if constexpr (is_map)
+            {
+                return reference(key(), value());
+            }
+            else
+            {
+                return key();
+            }
+        }
+
+        [[nodiscard]] constexpr auto operator->() const
+        {
+            if constexpr (is_map)
+            {
+                return detail::btree_arrow_proxy<reference>{**this};
+            }
+            else
+            {
+                return &key();
+            }
+        }
+
+        constexpr basic_iterator &operator++()
+        {
+            // the end iterator sits one past the last key of the last leaf.
+            if (++m_index == m_leaf->size && m_leaf->next != nullptr)
+            {
+                m_leaf  = m_leaf->next;
+                m_index = 0;
+            }
+            return *this;
+        }
+
+        constexpr basic_iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr basic_iterator &operator--()
+        {
+            if (m_index == 0)
+            {
+                m_leaf  = m_leaf->prev;
+                m_index = m_leaf->size;
+            }
+            --m_index;
+            return *this;
+        }
+
+        constexpr basic_iterator operator--(int)
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const basic_iterator &other) const
+        {
+            return m_leaf == other.m_leaf && m_index == other.m_index;
+        }
+
+      private:
+        friend class basic_btree;
+        friend class basic_iterator<true>;
+
+        constexpr basic_iterator(leaf_node *leaf, u32 index) : m_leaf(leaf), m_index(index)
+        {
+        }
+
+        leaf_node *m_leaf = nullptr;
+        u32 m_index       = 0;
+    };
+
+    // the number of keys in [keys, keys + size) which are less than the key.
+    [[nodiscard]] size_type lower_index(const Key *keys, size_type size, const Key &key) const
+    {
+        if constexpr (detail::btree_linear_search<Key, Compare>)
+        {
+            size_type count = 0;
+            for (size_type i = 0; i < node_capacity; ++i)
+            {
+                count += static_cast<size_type>((i < size) & (keys[i] < key));
+            }
+            return count;
+        }
+        else
+        {
+            return branchless_search(keys, size, [&](const Key &other) { return m_compare(other, key); });
+        }
+    }
+
+    // the number of keys in [keys, keys + size) which are not greater than the key.
+    [[nodiscard]] size_type upper_index(const Key *keys, size_type size, const Key &key) const
+    {
+        if constexpr (detail::btree_linear_search<Key, Compare>)
+        {
+            size_type count = 0;
+            for (size_type i = 0; i < node_capacity; ++i)
+            {
+                count += static_cast<size_type>((i < size) & !(key < keys[i]));
+            }
+            return count;
+        }
+        else
+        {
+            return branchless_search(keys, size, [&](const Key &other) { return !m_compare(key, other); });
+        }
+    }
+
+    // the length of the prefix of keys which satisfy the predicate. The halving step is a conditional move rather than
+    // a branch, so the loop runs the same number of times for every key.
+    template <class Predicate>
+    [[nodiscard]] static size_type branchless_search(const Key *keys, size_type size, Predicate predicate)
+    {
+        if (size == 0)
+        {
+            return 0;
+        }
+        const auto *base = keys;
+        while (size > 1)
+        {
+            const auto half = size / 2;
+            base            = predicate(base[half]) ? base + half : base;
+            size -= half;
+        }
+        return static_cast<size_type>(base - keys) + static_cast<size_type>(predicate(*base));
+    }
+
+    leaf_node *descend(const Key &key, path_type &path) const
+    {
+        auto *n = m_root;
+        while (!n->leaf)
+        {
+            auto *inner     = static_cast<inner_node *>(n);
+            const auto slot = static_cast<u32>(upper_index(inner->keys.data(), inner->size, key));
+            path.nodes[path.depth] = inner;
+            path.slots[path.depth] = slot;
+            ++path.depth;
+            n = inner->children[slot];
+        }
+        return static_cast<leaf_node *>(n);
+    }
+
+    // an index one past the end of a leaf is moved to the start of the next leaf, unless it is the end iterator.
+    static iterator make_iterator(leaf_node *leaf, size_type index)
+    {
+        if (index == leaf->size && leaf->next != nullptr)
+        {
+            return iterator(leaf->next, 0);
+        }
+        return iterator(leaf, static_cast<u32>(index));
+    }
+
+    template <class K, class... Args>
+    std::pair<iterator, bool> emplace_unique(K &&key, Args &&...args)
+    {
+        if (m_root == nullptr)
+        {
+            m_root = new leaf_node();
+            link_after(nullptr, static_cast<leaf_node *>(m_root));
+        }
+
+        path_type path;
+        auto *leaf = descend(key, path);
+        auto index = lower_index(leaf->keys.data(), leaf->size, key);
+        if (index < leaf->size && !m_compare(key, leaf->keys[index]))
+        {
+            return {iterator(leaf, static_cast<u32>(index)), false};
+        }
+
+        if (leaf->size == node_capacity)
+        {
+            // keys appended to the end of the tree leave the full leaf as it is, so that ascending inserts fill the
+            // leaves completely instead of leaving every one of them half empty.
+            auto *right       = new leaf_node();
+            const auto middle = index == node_capacity && leaf->next == nullptr ? node_capacity : node_capacity / 2;
+            move_keys(leaf, middle, node_capacity, right, 0);
+            right->size = static_cast<u32>(node_capacity - middle);
+            leaf->size  = static_cast<u32>(middle);
+            link_after(leaf, right);
+
+            if (index >= middle)
+            {
+                leaf = right;
+                index -= middle;
+            }
+            insert_into_leaf(leaf, index, static_cast<K &&>(key), static_cast<Args &&>(args)...);
+            insert_into_parents(path, Key(right->keys[0]), right);
+        }
+        else
+        {
+            insert_into_leaf(leaf, index, static_cast<K &&>(key), static_cast<Args &&>(args)...);
+        }
+
+        ++m_size;
+        return {iterator(leaf, static_cast<u32>(index)), true};
+    }
+
+    template <class K, class... Args>
+    static void insert_into_leaf(leaf_node *leaf, size_type index, K &&key, Args &&...args)
+    {
+        auto *keys = leaf->keys.data();
+        std::move_backward(keys + index, keys + leaf->size, keys + leaf->size + 1);
+        keys[index] = static_cast<K &&>(key);
+        if constexpr (is_map)
+        {
+            auto *values = leaf->values.data();
+            std::move_backward(values + index, values + leaf->size, values + leaf->size + 1);
+            values[index] = mapped_storage(static_cast<Args &&>(args)...);
+        }
+        ++leaf->size;
+    }
+
+    // adds the separator and the new right sibling of the last node on the path to its parent, splitting full parents
+    // all the way up to the root if need be.
+    void insert_into_parents(path_type &path, Key separator, node *child)
+    {
+        while (path.depth > 0)
+        {
+            --path.depth;
+            auto *parent    = path.nodes[path.depth];
+            const auto slot = path.slots[path.depth];
+            if (parent->size < node_capacity)
+            {
+                insert_child(parent, slot, qz::move(separator), child);
+                return;
+            }
+
+            // lay out the node_capacity + 1 keys in order, then hand the upper half to a new node and promote the
+            // middle key.
+            array<Key, node_capacity + 1> keys;
+            array<node *, node_capacity + 2> children;
+            std::move(parent->keys.data(), parent->keys.data() + slot, keys.data());
+            keys[slot] = qz::move(separator);
+            std::move(parent->keys.data() + slot, parent->keys.data() + node_capacity, keys.data() + slot + 1);
+            std::copy(parent->children.data(), parent->children.data() + slot + 1, children.data());
+            children[slot + 1] = child;
+            std::copy(parent->children.data() + slot + 1, parent->children.data() + node_capacity + 1,
+                      children.data() + slot + 2);
+
+            constexpr auto middle = (node_capacity + 1) / 2;
+            auto *right           = new inner_node();
+            std::move(keys.data(), keys.data() + middle, parent->keys.data());
+            std::copy(children.data(), children.data() + middle + 1, parent->children.data());
+            parent->size = static_cast<u32>(middle);
+            std::move(keys.data() + middle + 1, keys.data() + node_capacity + 1, right->keys.data());
+            std::copy(children.data() + middle + 1, children.data() + node_capacity + 2, right->children.data());
+            right->size = static_cast<u32>(node_capacity - middle);
+
+            separator = qz::move(keys[middle]);
+            child     = right;
+        }
+
+        auto *root        = new inner_node();
+        root->keys[0]     = qz::move(separator);
+        root->children[0] = m_root;
+        root->children[1] = child;
+        root->size        = 1;
+        m_root            = root;
+    }
+
+    static void insert_child(inner_node *parent, size_type slot, Key separator, node *child)
+    {
+        auto *keys     = parent->keys.data();
+        auto *children = parent->children.data();
+        std::move_backward(keys + slot, keys + parent->size, keys + parent->size + 1);
+        std::copy_backward(children + slot + 1, children + parent->size + 1, children + parent->size + 2);
+        keys[slot]         = qz::move(separator);
+        children[slot + 1] = child;
+        ++parent->size;
+    }
+
+    // removes the key at the given index along with the child to its right.
+    static void erase_child(inner_node *parent, size_type index)
+    {
+        auto *keys     = parent->keys.data();
+        auto *children = parent->children.data();
+        std::move(keys + index + 1, keys + parent->size, keys + index);
+        std::copy(children + index + 2, children + parent->size + 1, children + index + 1);
+        --parent->size;
+    }
+
+    static void erase_from_leaf(leaf_node *leaf, size_type index)
+    {
+        auto *keys = leaf->keys.data();
+        std::move(keys + index + 1, keys + leaf->size, keys + index);
+        if constexpr (is_map)
+        {
+            auto *values = leaf->values.data();
+            std::move(values + index + 1, values + leaf->size, values + index);
+        }
+        --leaf->size;
+    }
+
+    // moves the keys and values in [first, last) of one leaf to the given position of another, which has room.
+    static void move_keys(leaf_node *from, size_type first, size_type last, leaf_node *to, size_type index)
+    {
+        std::move(from->keys.data() + first, from->keys.data() + last, to->keys.data() + index);
+        if constexpr (is_map)
+        {
+            std::move(from->values.data() + first, from->values.data() + last, to->values.data() + index);
+        }
+    }
+
+    void rebalance_leaf(leaf_node *leaf, inner_node *parent, size_type slot)
+    {
+        auto *left  = slot > 0 ? static_cast<leaf_node *>(parent->children[slot - 1]) : nullptr;
+        auto *right = slot < parent->size ? static_cast<leaf_node *>(parent->children[slot + 1]) : nullptr;
+
+        if (left != nullptr && left->size > min_keys)
+        {
+            auto *keys = leaf->keys.data();
+            std::move_backward(keys, keys + leaf->size, keys + leaf->size + 1);
+            if constexpr (is_map)
+            {
+                auto *values = leaf->values.data();
+                std::move_backward(values, values + leaf->size, values + leaf->size + 1);
+            }
+            move_keys(left, left->size - 1, left->size, leaf, 0);
+            --left->size;
+            ++leaf->size;
+            parent->keys[slot - 1] = leaf->keys[0];
+        }
+        else if (right != nullptr && right->size > min_keys)
+        {
+            move_keys(right, 0, 1, leaf, leaf->size);
+            ++leaf->size;
+            erase_from_leaf(right, 0);
+            parent->keys[slot] = right->keys[0];
+        }
+        else if (left != nullptr)
+        {
+            merge_leaves(left, leaf);
+            erase_child(parent, slot - 1);
+        }
+        else
+        {
+            merge_leaves(leaf, right);
+            erase_child(parent, slot);
+        }
+    }
+
+    void rebalance_inner(inner_node *n, inner_node *parent, size_type slot)
+    {
+        auto *left  = slot > 0 ? static_cast<inner_node *>(parent->children[slot - 1]) : nullptr;
+        auto *right = slot < parent->size ? static_cast<inner_node *>(parent->children[slot + 1]) : nullptr;
+
+        // borrowing rotates a key through the parent, since separators of inner nodes are not duplicated below.
+        if (left != nullptr && left->size > min_keys)
+        {
+            auto *keys     = n->keys.data();
+            auto *children = n->children.data();
+            std::move_backward(keys, keys + n->size, keys + n->size + 1);
+            std::copy_backward(children, children + n->size + 1, children + n->size + 2);
+            keys[0]                = qz::move(parent->keys[slot - 1]);
+            children[0]            = left->children[left->size];
+            parent->keys[slot - 1] = qz::move(left->keys[left->size - 1]);
+            --left->size;
+            ++n->size;
+        }
+        else if (right != nullptr && right->size > min_keys)
+        {
+            n->keys[n->size]         = qz::move(parent->keys[slot]);
+            n->children[n->size + 1] = right->children[0];
+            ++n->size;
+            parent->keys[slot] = qz::move(right->keys[0]);
+            std::move(right->keys.data() + 1, right->keys.data() + right->size, right->keys.data());
+            std::copy(right->children.data() + 1, right->children.data() + right->size + 1, right->children.data());
+            --right->size;
+        }
+        else if (left != nullptr)
+        {
+            merge_inners(left, n, parent, slot - 1);
+        }
+        else
+        {
+            merge_inners(n, right, parent, slot);
+        }
+    }
+
+    void merge_leaves(leaf_node *left, leaf_node *right)
+    {
+        move_keys(right, 0, right->size, left, left->size);
+        left->size += right->size;
+        left->next = right->next;
+        if (right->next != nullptr)
+        {
+            right->next->prev = left;
+        }
+        else
+        {
+            m_last = left;
+        }
+        delete right;
+    }
+
+    // pulls the separator between the two nodes down into the left one, followed by the contents of the right one.
+    static void merge_inners(inner_node *left, inner_node *right, inner_node *parent, size_type index)
+    {
+        left->keys[left->size] = qz::move(parent->keys[index]);
+        std::move(right->keys.data(), right->keys.data() + right->size, left->keys.data() + left->size + 1);
+        std::copy(right->children.data(), right->children.data() + right->size + 1,
+                  left->children.data() + left->size + 1);
+        left->size += right->size + 1;
+        delete right;
+        erase_child(parent, index);
+    }
+
+    // links the new leaf after the given one, which is null for the first leaf.
+    void link_after(leaf_node *leaf, leaf_node *next)
+    {
+        next->prev = leaf;
+        next->next = leaf != nullptr ? leaf->next : nullptr;
+        if (leaf != nullptr)
+        {
+            leaf->next = next;
+        }
+        else
+        {
+            m_first = next;
+        }
+        if (next->next != nullptr)
+        {
+            next->next->prev = next;
+        }
+        else
+        {
+            m_last = next;
+        }
+    }
+
+    template <class Element>
+    static const Key &element_key(const Element &element)
+    {
+        if constexpr (is_map)
+        {
+            return element.first;
+        }
+        else
+        {
+            return element;
+        }
+    }
+
+    // the smallest key below the given node, which separates it from its left sibling.
+    static const Key &lowest_key(const node *n)
+    {
+        while (!n->leaf)
+        {
+            n = static_cast<const inner_node *>(n)->children[0];
+        }
+        return static_cast<const leaf_node *>(n)->keys[0];
+    }
+
+    static inner_node *make_inner(node *const *children, size_type count)
+    {
+        auto *inner = new inner_node();
+        fill_inner(inner, children, count);
+        return inner;
+    }
+
+    static void fill_inner(inner_node *inner, node *const *children, size_type count)
+    {
+        inner->children[0] = children[0];
+        for (size_type i = 1; i < count; ++i)
+        {
+            inner->keys[i - 1]  = lowest_key(children[i]);
+            inner->children[i] = children[i];
+        }
+        inner->size = static_cast<u32>(count - 1);
+    }
+
+    // splits the keys of two neighbouring leaves evenly between them.
+    static void even_out_leaves(leaf_node *left, leaf_node *right)
+    {
+        const auto moved = (left->size + right->size) / 2 - right->size;
+        auto *keys       = right->keys.data();
+        std::move_backward(keys, keys + right->size, keys + right->size + moved);
+        if constexpr (is_map)
+        {
+            auto *values = right->values.data();
+            std::move_backward(values, values + right->size, values + right->size + moved);
+        }
+        move_keys(left, left->size - moved, left->size, right, 0);
+        left->size -= moved;
+        right->size += moved;
+    }
+
+    // splits the children of two neighbouring inner nodes evenly between them.
+    static void even_out_inners(inner_node *left, inner_node *right)
+    {
+        array<node *, 2 * (node_capacity + 1)> children;
+        const auto left_count  = left->size + 1;
+        const auto total_count = left_count + right->size + 1;
+        std::copy(left->children.data(), left->children.data() + left_count, children.data());
+        std::copy(right->children.data(), right->children.data() + right->size + 1, children.data() + left_count);
+
+        const auto split = total_count - total_count / 2;
+        fill_inner(left, children.data(), split);
+        fill_inner(right, children.data() + split, total_count - split);
+    }
+
+    static void destroy(node *n)
+    {
+        if (n->leaf)
+        {
+            delete static_cast<leaf_node *>(n);
+            return;
+        }
+        auto *inner = static_cast<inner_node *>(n);
+        for (size_type i = 0; i <= inner->size; ++i)
+        {
+            destroy(inner->children[i]);
+        }
+        delete inner;
+    }
+
+    node *m_root       = nullptr;
+    leaf_node *m_first = nullptr;
+    leaf_node *m_last  = nullptr;
+    size_type m_size   = 0;
+    [[no_unique_address]] Compare m_compare;
+};
+
+///
+/// @ingroup QzContainers
+///
+/// @brief An ordered map implemented as a B+ tree with cache line sized nodes. See qz::basic_btree.
+/// @tparam Key The key type. Must be default constructible.
+/// @tparam T The mapped type. Must be default constructible.
+/// @tparam Compare The strict weak ordering of the keys.
+///
+template <class Key, class T, class Compare = std::less<Key>>
+using btree_map = basic_btree<Key, T, Compare>;
+
+///
+/// @ingroup QzContainers
+///
+/// @brief An ordered set implemented as a B+ tree with cache line sized nodes. See qz::basic_btree.
+/// @tparam Key The key type. Must be default constructible.
+/// @tparam Compare The strict weak ordering of the keys.
+///
+template <class Key, class Compare = std::less<Key>>
+using btree_set = basic_btree<Key, void, Compare>;
+
+} // namespace qz
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+
+/// @cond Undocumented
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define QZ_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define QZ_HAS_TSC 1
+#else
+    #define QZ_HAS_TSC 0
+#endif
+/// @endcond
+
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzClock Clocks
+/// @brief Low overhead clocks for timestamping and latency measurement. Include <quartz/clock.hpp> to use them.
+/// @{
+///
+
+/// @cond Undocumented
+namespace detail
+{
+
+struct tsc_calibration
+{
+    // true if the processor has an invariant time stamp counter, else the steady clock is used instead.
+    bool uses_tsc;
+    // nanoseconds per tick and the tick & nanosecond values at calibration time.
+    f64 ns_per_tick;
+    u64 base_ticks;
+    s64 base_ns;
+};
+
+// calibrates on first use. thread-safe.
+const tsc_calibration &get_tsc_calibration();
+
+} // namespace detail
+/// @endcond
+
+///
+/// @brief A clock reading the processor's time stamp counter, converted to nanoseconds with a one-time calibration.
+/// @details Reading the time stamp counter costs a few nanoseconds and never leaves user space, unlike
+/// `std::chrono::steady_clock` which may fall back to a system call under some hypervisors. The tick rate is
+/// calibrated against `std::chrono::steady_clock` the first time it is needed (taking about 10 ms), or eagerly by
+/// calling calibrate() at start up. On processors without an invariant time stamp counter the clock falls back to
+/// `std::chrono::steady_clock`, in which case a tick is one nanosecond.
+///
+/// @note For measuring short intervals, prefer taking raw ticks() and converting the difference with to_duration(),
+/// which keeps the conversion out of the measured region.
+///
+class tsc_clock
+{
+  public:
+    using rep        = s64;
+    using period     = std::nano;
+    using duration   = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<tsc_clock, duration>;
+
+    static constexpr bool is_steady = true;
+
+    /// @brief Get the current time. Calibrates the clock if it has not been calibrated yet.
+    [[nodiscard]] static time_point now() noexcept
+    {
+        const auto &calibration = detail::get_tsc_calibration();
+        if (!calibration.uses_tsc)
+        {
+            return time_point(duration(steady_ns()));
+        }
+        const auto elapsed = static_cast<f64>(static_cast<s64>(read_tsc() - calibration.base_ticks));
+        return time_point(duration(calibration.base_ns + static_cast<rep>(elapsed * calibration.ns_per_tick)));
+    }
+
+    /// @brief Read the raw tick counter. Not ordered with respect to surrounding loads and stores.
+    [[nodiscard]] static u64 ticks() noexcept
+    {
+        return uses_tsc() ? read_tsc() : static_cast<u64>(steady_ns());
+    }
+
+    /// @brief Read the raw tick counter, waiting for all previous instructions to complete first (`rdtscp`).
+    [[nodiscard]] static u64 ticks_ordered() noexcept
+    {
+#if QZ_HAS_TSC
+        if (uses_tsc())
+        {
+            unsigned int aux = 0;
+            return __rdtscp(&aux);
+        }
+#endif
+        return static_cast<u64>(steady_ns());
+    }
+
+    /// @brief Convert a number of ticks, e.g. the difference between two ticks() values, into a duration.
+    [[nodiscard]] static duration to_duration(u64 ticks) noexcept
+    {
+        return duration(static_cast<rep>(static_cast<f64>(ticks) * detail::get_tsc_calibration().ns_per_tick));
+    }
+
+    /// @brief True if the clock reads the time stamp counter, false if it falls back to the steady clock.
+    [[nodiscard]] static bool uses_tsc() noexcept
+    {
+        return detail::get_tsc_calibration().uses_tsc;
+    }
+
+    /// @brief Calibrate the clock now instead of on first use.
+    static void calibrate() noexcept
+    {
+        static_cast<void>(detail::get_tsc_calibration());
+    }
+
+  private:
+    [[nodiscard]] static u64 read_tsc() noexcept
+    {
+#if QZ_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    [[nodiscard]] static s64 steady_ns() noexcept
+    {
+        return std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+///
+/// @}
+///
+
+} // namespace qz
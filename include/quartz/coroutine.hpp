@@ -0,0 +1,652 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+
+#include "quartz/assert.hpp"
+#include "quartz/macros.hpp"
+#include "quartz/optional.hpp"
+#include "quartz/types.hpp"
+#include "quartz/utilities.hpp"
+
+#if !defined(QZ_NO_EXCEPTIONS)
+    #include <exception>
+#else
+    #include <cstdlib>
+#endif
+
+///
+/// @defgroup QzCoroutines Coroutines
+/// @brief Coroutine return types and the building blocks for running them on a single thread. Include
+/// <quartz/coroutine.hpp> to use them.
+///
+
+namespace qz
+{
+
+///
+/// @ingroup QzCoroutines
+///
+/// @brief A bump allocator for coroutine frames, carved out of a caller provided buffer.
+/// @details A coroutine of any of the qz coroutine types takes its frame from an arena when its first parameter, or
+/// its first parameter after the object for member functions and lambdas, is a `qz::frame_arena &` followed by at
+/// most eight more parameters. Coroutines with more parameters take their frames from the heap. Frames are usually
+/// created and destroyed in LIFO order, so freeing the most recent frame gives its memory back, and the arena
+/// rewinds to the start once no frames are left. When the buffer runs out, frames fall back to the global heap.
+///
+/// The compiler may elide the frame allocation altogether when a coroutine does not outlive its caller and its body
+/// is visible, in which case the arena is not touched.
+///
+class frame_arena
+{
+  public:
+    /// @brief The alignment of every frame, which is the alignment guaranteed by the global operator new.
+    static constexpr usz alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    // CONSTRUCTORS
+
+    /// @brief Construct an arena over the given buffer, which must outlive the arena and every frame taken from it.
+    explicit frame_arena(std::span<std::byte> buffer) noexcept
+    {
+        // the start of the buffer is aligned up, and the end is rounded down to a multiple of the alignment.
+        void *data = buffer.data();
+        auto space = buffer.size();
+        if (std::align(alignment, alignment, data, space) != nullptr)
+        {
+            m_data     = static_cast<std::byte *>(data);
+            m_capacity = space / alignment * alignment;
+        }
+    }
+
+    frame_arena(const frame_arena &)            = delete;
+    frame_arena &operator=(const frame_arena &) = delete;
+
+    // METHODS
+
+    /// @brief Allocate memory for a frame of the given size.
+    /// @return A pointer to the memory, or nullptr if the arena has no room left.
+    [[nodiscard]] void *allocate(usz size) noexcept
+    {
+        size = round_up(size);
+        if (size > m_capacity - m_offset)
+        {
+            return nullptr;
+        }
+        auto *pointer = m_data + m_offset;
+        m_offset += size;
+        ++m_live;
+        return pointer;
+    }
+
+    /// @brief Free the memory of a frame previously allocated from this arena.
+    void deallocate(void *pointer, usz size) noexcept
+    {
+        QZ_ASSERT_MSG(m_live > 0, "Frame was not allocated from this arena.");
+        if (static_cast<std::byte *>(pointer) + round_up(size) == m_data + m_offset)
+        {
+            m_offset -= round_up(size);
+        }
+        if (--m_live == 0)
+        {
+            m_offset = 0;
+        }
+    }
+
+    /// @brief Get the number of bytes currently in use, including memory of freed frames not yet given back.
+    [[nodiscard]] usz used() const
+    {
+        return m_offset;
+    }
+
+    /// @brief Get the number of usable bytes in the arena.
+    [[nodiscard]] usz capacity() const
+    {
+        return m_capacity;
+    }
+
+  private:
+    [[nodiscard]] static constexpr usz round_up(usz size)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    std::byte *m_data = nullptr;
+    usz m_capacity    = 0;
+    usz m_offset      = 0;
+    usz m_live        = 0;
+};
+
+/// @cond Undocumented
+namespace detail
+{
+
+// frame allocation shared by all promise types. Every frame is preceded by a header recording the arena it was taken
+// from, or null for frames on the heap, so that operator delete knows where to return it.
+//
+// GCC warns about a mismatched delete whenever it sees a frame from a templated operator new reach the usual operator
+// delete, so the overloads are plain functions. The parameters of the coroutine are matched by converting types
+// instead of a parameter pack, and allocation is defined out of line.
+void *allocate_frame(frame_arena *arena, usz size);
+void deallocate_frame(void *frame, usz size) noexcept;
+
+// binds to any parameter of a coroutine following the arena.
+struct frame_parameter
+{
+    frame_parameter() = default;
+
+    template <class T>
+    frame_parameter(T && /* unused */) // NOLINT (implicit conversion)
+    {
+    }
+};
+
+// binds to the object of a member coroutine or lambda, but not to an arena, so that a coroutine taking two arenas
+// does not match both overloads.
+struct frame_object
+{
+    template <class T>
+        requires(!std::is_same_v<std::remove_cvref_t<T>, frame_arena>)
+    frame_object(T && /* unused */) // NOLINT (implicit conversion)
+    {
+    }
+};
+
+struct frame_allocation
+{
+    static void *operator new(usz size)
+    {
+        return allocate_frame(nullptr, size);
+    }
+
+    static void *operator new(usz size, frame_arena &arena, frame_parameter = {}, frame_parameter = {},
+                              frame_parameter = {}, frame_parameter = {}, frame_parameter = {}, frame_parameter = {},
+                              frame_parameter = {}, frame_parameter = {})
+    {
+        return allocate_frame(&arena, size);
+    }
+
+    static void *operator new(usz size, frame_object /* unused */, frame_arena &arena, frame_parameter = {},
+                              frame_parameter = {}, frame_parameter = {}, frame_parameter = {}, frame_parameter = {},
+                              frame_parameter = {}, frame_parameter = {}, frame_parameter = {})
+    {
+        return allocate_frame(&arena, size);
+    }
+
+    static void operator delete(void *frame, usz size) noexcept
+    {
+        deallocate_frame(frame, size);
+    }
+};
+
+// exceptions escaping a coroutine are kept in its promise and rethrown in the code which resumed it.
+struct exception_slot
+{
+#if !defined(QZ_NO_EXCEPTIONS)
+    void unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+    void rethrow_if_exception() const
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+    std::exception_ptr m_exception;
+#else
+    [[noreturn]] void unhandled_exception() noexcept
+    {
+        std::abort();
+    }
+
+    void rethrow_if_exception() const
+    {
+    }
+#endif
+};
+
+template <class T>
+struct task_result
+{
+    template <class U>
+    void return_value(U &&value)
+    {
+        m_value.emplace(static_cast<U &&>(value));
+    }
+
+    T take_result()
+    {
+        QZ_ASSERT_MSG(m_value.has_value(), "Task has not completed.");
+        return qz::move(*m_value);
+    }
+
+    optional<T> m_value;
+};
+
+template <>
+struct task_result<void>
+{
+    void return_void() noexcept
+    {
+    }
+
+    void take_result() noexcept
+    {
+    }
+};
+
+} // namespace detail
+/// @endcond
+
+///
+/// @ingroup QzCoroutines
+///
+/// @brief Wraps a generator so that yielding it from another generator yields each of its elements in turn.
+/// @details Only refers to the generator, which is moved from once yielded. Only construct it inside the `co_yield`
+/// expression, from a temporary or a moved generator.
+///
+template <class Generator>
+struct elements_of
+{
+    Generator &&generator;
+};
+
+template <class Generator>
+elements_of(Generator &&) -> elements_of<Generator>;
+
+///
+/// @ingroup QzCoroutines
+///
+/// @brief A lazily evaluated sequence of values produced by a coroutine, consumed as an input range.
+/// @details The coroutine runs up to its next `co_yield` each time the iterator is advanced, and the yielded value is
+/// read in place from the coroutine frame, without copying.
+///
+/// Yielding `qz::elements_of(other)` runs a nested generator. Control passes between the two frames by symmetric
+/// transfer, and the consumer always resumes the innermost active generator directly, so the cost of advancing stays
+/// constant however deep generators are nested.
+///
+/// @tparam T The type of the values. For non-reference types, values are exposed as const references.
+///
+template <class T>
+class generator
+{
+  public:
+    // TYPEDEFS
+
+    using value_type = std::remove_cvref_t<T>;
+    using reference  = std::conditional_t<std::is_reference_v<T>, T, const T &>;
+
+    class promise_type;
+    class iterator;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    class promise_type : public detail::frame_allocation, public detail::exception_slot
+    {
+      public:
+        generator get_return_object() noexcept
+        {
+            m_leaf = handle_type::from_promise(*this);
+            return generator(m_leaf);
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept
+        {
+            // a nested generator hands control back to the generator which yielded it.
+            struct final_awaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(handle_type handle) noexcept
+                {
+                    auto &promise = handle.promise();
+                    if (promise.m_parent)
+                    {
+                        promise.m_root->m_leaf = promise.m_parent;
+                        return promise.m_parent;
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept
+                {
+                }
+            };
+            return final_awaiter{};
+        }
+
+        std::suspend_always yield_value(reference value) noexcept
+        {
+            m_root->m_value = std::addressof(value);
+            return {};
+        }
+
+        auto yield_value(elements_of<generator> nested) noexcept
+        {
+            struct nested_awaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return !m_generator.m_handle;
+                }
+
+                std::coroutine_handle<> await_suspend(handle_type parent) noexcept
+                {
+                    auto child           = m_generator.m_handle;
+                    auto &child_promise  = child.promise();
+                    child_promise.m_root = parent.promise().m_root;
+                    child_promise.m_parent   = parent;
+                    child_promise.m_root->m_leaf = child;
+                    return child;
+                }
+
+                void await_resume()
+                {
+                    if (m_generator.m_handle)
+                    {
+                        m_generator.m_handle.promise().rethrow_if_exception();
+                    }
+                }
+
+                generator m_generator;
+            };
+            return nested_awaiter{qz::move(nested.generator)};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        // generators only suspend at co_yield.
+        template <class U>
+        void await_transform(U &&) = delete;
+
+      private:
+        friend class generator;
+
+        promise_type *m_root = this;
+        handle_type m_leaf;
+        handle_type m_parent;
+        std::add_pointer_t<reference> m_value = nullptr;
+    };
+
+    ///
+    /// @brief An input iterator over the values of a generator, which resumes the generator when advanced.
+    ///
+    class iterator
+    {
+      public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type       = typename generator::value_type;
+        using difference_type  = ssz;
+
+        iterator() = default;
+
+        [[nodiscard]] reference operator*() const
+        {
+            return static_cast<reference>(*m_handle.promise().m_value);
+        }
+
+        iterator &operator++()
+        {
+            resume(m_handle);
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        [[nodiscard]] friend bool operator==(const iterator &it, std::default_sentinel_t /* unused */)
+        {
+            return it.m_handle.done();
+        }
+
+      private:
+        friend class generator;
+
+        explicit iterator(handle_type handle) : m_handle(handle)
+        {
+        }
+
+        handle_type m_handle;
+    };
+
+    // CONSTRUCTORS
+
+    generator() noexcept = default;
+
+    generator(generator &&other) noexcept : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+
+    generator(const generator &) = delete;
+
+    ~generator()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    // METHODS
+
+    /// @brief Run the generator up to its first value. May only be called once.
+    [[nodiscard]] iterator begin()
+    {
+        QZ_ASSERT_MSG(m_handle, "Cannot iterate over an empty generator.");
+        resume(m_handle);
+        return iterator(m_handle);
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+    // OPERATOR OVERLOADS
+
+    generator &operator=(generator &&other) noexcept
+    {
+        qz::swap(m_handle, other.m_handle);
+        return *this;
+    }
+
+    generator &operator=(const generator &) = delete;
+
+  private:
+    explicit generator(handle_type handle) noexcept : m_handle(handle)
+    {
+    }
+
+    static void resume(handle_type root)
+    {
+        auto &promise = root.promise();
+        promise.m_leaf.resume();
+        promise.rethrow_if_exception();
+    }
+
+    handle_type m_handle;
+};
+
+///
+/// @ingroup QzCoroutines
+///
+/// @brief A lazily started asynchronous computation producing a single value.
+/// @details A task starts running when it is awaited, and resumes its awaiter by symmetric transfer when it
+/// completes, so chains of tasks awaiting each other neither grow the stack nor go through a scheduler. Top level
+/// tasks are run with qz::sync_wait.
+///
+/// @tparam T The type of the result, or void.
+///
+template <class T = void>
+class task
+{
+    static_assert(!std::is_reference_v<T>, "Tasks cannot return references.");
+
+  public:
+    // TYPEDEFS
+
+    using value_type = T;
+
+    class promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    class promise_type : public detail::frame_allocation,
+                         public detail::exception_slot,
+                         public detail::task_result<T>
+    {
+      public:
+        task get_return_object() noexcept
+        {
+            return task(handle_type::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept
+        {
+            struct final_awaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(handle_type handle) noexcept
+                {
+                    return handle.promise().m_continuation;
+                }
+
+                void await_resume() noexcept
+                {
+                }
+            };
+            return final_awaiter{};
+        }
+
+      private:
+        friend class task;
+
+        std::coroutine_handle<> m_continuation = std::noop_coroutine();
+    };
+
+    // CONSTRUCTORS
+
+    task() noexcept = default;
+
+    task(task &&other) noexcept : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+
+    task(const task &) = delete;
+
+    ~task()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    // METHODS
+
+    /// @brief True if the task has run to completion, else false.
+    [[nodiscard]] bool done() const noexcept
+    {
+        return m_handle && m_handle.done();
+    }
+
+    /// @brief Get the underlying coroutine handle, which stays owned by the task.
+    [[nodiscard]] handle_type handle() const noexcept
+    {
+        return m_handle;
+    }
+
+    // OPERATOR OVERLOADS
+
+    task &operator=(task &&other) noexcept
+    {
+        qz::swap(m_handle, other.m_handle);
+        return *this;
+    }
+
+    task &operator=(const task &) = delete;
+
+    /// @brief Start the task, and resume the awaiting coroutine with its result once it completes.
+    auto operator co_await() && noexcept
+    {
+        struct awaiter
+        {
+            bool await_ready() noexcept
+            {
+                return m_handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+            {
+                m_handle.promise().m_continuation = continuation;
+                return m_handle;
+            }
+
+            T await_resume()
+            {
+                m_handle.promise().rethrow_if_exception();
+                return m_handle.promise().take_result();
+            }
+
+            handle_type m_handle;
+        };
+        QZ_ASSERT_MSG(m_handle, "Cannot await an empty task.");
+        return awaiter{m_handle};
+    }
+
+  private:
+    explicit task(handle_type handle) noexcept : m_handle(handle)
+    {
+    }
+
+    handle_type m_handle;
+};
+
+///
+/// @ingroup QzCoroutines
+///
+/// @brief Run a task to completion on the calling thread and return its result.
+/// @details Everything the task awaits must complete on this thread without an external event loop, e.g. other tasks.
+/// Reports an assertion failure in debug builds if the task is left suspended.
+///
+template <class T>
+T sync_wait(task<T> &&task)
+{
+    auto handle = task.handle();
+    QZ_ASSERT_MSG(handle && !handle.done(), "Cannot wait on an empty or completed task.");
+    handle.resume();
+    QZ_ASSERT_MSG(handle.done(), "Task suspended without a way of being resumed.");
+    handle.promise().rethrow_if_exception();
+    return handle.promise().take_result();
+}
+
+} // namespace qz
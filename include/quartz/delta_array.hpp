@@ -0,0 +1,582 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/// @cond Undocumented
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <immintrin.h>
+    #define QZ_DELTA_ARRAY_SIMD 1
+#else
+    #define QZ_DELTA_ARRAY_SIMD 0
+#endif
+/// @endcond
+
+#include "quartz/array.hpp"
+#include "quartz/assert.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+/// @cond Undocumented
+namespace detail
+{
+
+// LEB128: 7 bits per byte, with the top bit set on every byte but the last.
+inline void varint_encode(u64 value, std::vector<u8> &output)
+{
+    while (value >= 0x80)
+    {
+        output.push_back(static_cast<u8>(value | 0x80));
+        value >>= 7;
+    }
+    output.push_back(static_cast<u8>(value));
+}
+
+[[nodiscard]] inline u64 varint_decode(const u8 *&input)
+{
+    u64 value  = 0;
+    u32 shift  = 0;
+    u8 current = 0;
+    do
+    {
+        current = *input++;
+        value |= static_cast<u64>(current & 0x7F) << shift;
+        shift += 7;
+    } while ((current & 0x80) != 0);
+    return value;
+}
+
+// maps small negative and positive numbers to small unsigned numbers, so that they encode into few varint bytes.
+[[nodiscard]] constexpr u64 zigzag_encode(s64 value)
+{
+    return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63);
+}
+
+[[nodiscard]] constexpr s64 zigzag_decode(u64 value)
+{
+    return static_cast<s64>((value >> 1) ^ (0 - (value & 1)));
+}
+
+#if QZ_DELTA_ARRAY_SIMD
+// the operations on a SIMD register of 64-bit or 32-bit lanes used for decoding delta arrays. 32 bytes with AVX2, 16
+// bytes with SSE2.
+template <usz LaneSize>
+struct simd_lanes
+{
+    #if defined(__AVX2__)
+    using register_type = __m256i;
+    #else
+    using register_type = __m128i;
+    #endif
+
+    static constexpr usz register_size = sizeof(register_type);
+
+    static register_type broadcast(u64 value)
+    {
+    #if defined(__AVX2__)
+        return LaneSize == 8 ? _mm256_set1_epi64x(static_cast<s64>(value)) : _mm256_set1_epi32(static_cast<s32>(value));
+    #else
+        return LaneSize == 8 ? _mm_set1_epi64x(static_cast<s64>(value)) : _mm_set1_epi32(static_cast<s32>(value));
+    #endif
+    }
+
+    static register_type load(const void *source)
+    {
+    #if defined(__AVX2__)
+        return _mm256_loadu_si256(static_cast<const register_type *>(source));
+    #else
+        return _mm_loadu_si128(static_cast<const register_type *>(source));
+    #endif
+    }
+
+    static void store(void *destination, register_type value)
+    {
+    #if defined(__AVX2__)
+        _mm256_storeu_si256(static_cast<register_type *>(destination), value);
+    #else
+        _mm_storeu_si128(static_cast<register_type *>(destination), value);
+    #endif
+    }
+
+    // shifts by at least the lane width yield zero.
+    static register_type shift_right(register_type value, u32 shift)
+    {
+        const auto count = _mm_cvtsi32_si128(static_cast<int>(shift));
+    #if defined(__AVX2__)
+        return LaneSize == 8 ? _mm256_srl_epi64(value, count) : _mm256_srl_epi32(value, count);
+    #else
+        return LaneSize == 8 ? _mm_srl_epi64(value, count) : _mm_srl_epi32(value, count);
+    #endif
+    }
+
+    static register_type shift_left(register_type value, u32 shift)
+    {
+        const auto count = _mm_cvtsi32_si128(static_cast<int>(shift));
+    #if defined(__AVX2__)
+        return LaneSize == 8 ? _mm256_sll_epi64(value, count) : _mm256_sll_epi32(value, count);
+    #else
+        return LaneSize == 8 ? _mm_sll_epi64(value, count) : _mm_sll_epi32(value, count);
+    #endif
+    }
+
+    static register_type bit_or(register_type lhs, register_type rhs)
+    {
+    #if defined(__AVX2__)
+        return _mm256_or_si256(lhs, rhs);
+    #else
+        return _mm_or_si128(lhs, rhs);
+    #endif
+    }
+
+    static register_type bit_and(register_type lhs, register_type rhs)
+    {
+    #if defined(__AVX2__)
+        return _mm256_and_si256(lhs, rhs);
+    #else
+        return _mm_and_si128(lhs, rhs);
+    #endif
+    }
+
+    static register_type add(register_type lhs, register_type rhs)
+    {
+    #if defined(__AVX2__)
+        return LaneSize == 8 ? _mm256_add_epi64(lhs, rhs) : _mm256_add_epi32(lhs, rhs);
+    #else
+        return LaneSize == 8 ? _mm_add_epi64(lhs, rhs) : _mm_add_epi32(lhs, rhs);
+    #endif
+    }
+};
+#endif
+
+} // namespace detail
+/// @endcond
+
+///
+/// @ingroup QzContainers
+///
+/// @brief An append-only array of integers compressed with delta encoding, frame of reference and bit packing.
+/// @details Values are compressed in blocks of 128, viewed as rows of `lane_count` values. The block header holds the
+/// first row as varints: the first value, followed by the differences of the rest of the row to it. Every other value
+/// is stored as its difference to the value one row before it, minus the smallest such difference in the block (the
+/// frame of reference), bit packed at the width of the largest remaining offset. Monotonic columns like IDs and
+/// timestamps with a steady rate compress down to a few bits per value, and a column of equal values down to the
+/// header alone.
+///
+/// The packed offsets of a block are interleaved over `lane_count` lanes of 32 bytes in total, and every lane is
+/// delta encoded on its own. Decoding a block thus runs every step of the unpacking and the prefix sum on all lanes
+/// at once: for 32-bit and 64-bit values, a row of 8 or 4 values decodes with a handful of AVX2 (or twice as many SSE2)
+/// instructions, while other targets and types run the same lane loops in scalar code.
+///
+/// Appended values collect in an uncompressed block until it is full, so up to 127 values are stored as is.
+///
+/// @tparam T The integer type of the values.
+///
+template <class T>
+    requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+class delta_array
+{
+    using word_type = std::make_unsigned_t<T>;
+
+    static constexpr u32 word_bits = sizeof(T) * 8;
+
+  public:
+    // TYPEDEFS
+
+    using value_type = T;
+    using size_type  = usz;
+
+    /// @brief The number of values compressed together.
+    static constexpr usz block_size = 128;
+    /// @brief The number of interleaved lanes, which fill a 32-byte SIMD register.
+    static constexpr usz lane_count = 32 / sizeof(T);
+    /// @brief The number of values in every lane of a block.
+    static constexpr usz lane_length = block_size / lane_count;
+
+    // CONSTRUCTORS
+
+    delta_array() = default;
+
+    /// @brief Construct an array holding copies of the given values.
+    explicit delta_array(std::span<const T> values)
+    {
+        append(values);
+    }
+
+    // METHODS
+
+    /// @brief Append a value to the end of the array.
+    void push_back(T value)
+    {
+        m_pending[m_pending_size++] = value;
+        if (m_pending_size == block_size)
+        {
+            encode_block(m_pending.data());
+            m_pending_size = 0;
+        }
+    }
+
+    /// @brief Append copies of the given values to the end of the array.
+    void append(std::span<const T> values)
+    {
+        usz pos = 0;
+        // full blocks are compressed straight from the input.
+        if (m_pending_size == 0)
+        {
+            for (; pos + block_size <= values.size(); pos += block_size)
+            {
+                encode_block(values.data() + pos);
+            }
+        }
+        for (; pos < values.size(); ++pos)
+        {
+            push_back(values[pos]);
+        }
+    }
+
+    /// @brief Get the value at the given position. Only checked in debug builds.
+    /// @details Decodes a single lane of the block holding the value, which is O(block_size / lane_count). Prefer
+    /// decode() for reading consecutive values.
+    [[nodiscard]] T get(size_type index) const
+    {
+        QZ_ASSERT_MSG(index < size(), "Index out of bounds access.");
+        const auto block = index / block_size;
+        if (block == block_count())
+        {
+            return m_pending[index % block_size];
+        }
+
+        const auto header = read_header(block);
+        const auto lane   = index % lane_count;
+        const auto row    = index % block_size / lane_count;
+        const auto mask   = width_mask(header.bit_width);
+
+        auto value = header.starts[lane];
+        if (header.bit_width == 0)
+        {
+            // every offset is zero and nothing is packed.
+            return static_cast<T>(static_cast<word_type>(value + row * header.reference));
+        }
+        for (usz j = 0; j < row; ++j)
+        {
+            const auto bit   = j * header.bit_width;
+            const auto word  = bit / word_bits;
+            const auto shift = static_cast<u32>(bit % word_bits);
+
+            auto offset = static_cast<word_type>(load_word(header.payload, word * lane_count + lane) >> shift);
+            if (shift + header.bit_width > word_bits)
+            {
+                offset |= static_cast<word_type>(load_word(header.payload, (word + 1) * lane_count + lane)
+                                                 << (word_bits - shift));
+            }
+            value = static_cast<word_type>(value + header.reference + (offset & mask));
+        }
+        return static_cast<T>(value);
+    }
+
+    /// @brief Decode consecutive values, starting at the given position, into the output span.
+    /// @details Meant for streaming through the array in chunks: full blocks are decoded straight into the span, so
+    /// spans of a multiple of block_size values starting at a block boundary avoid any copying.
+    /// @return The number of values decoded, which is less than the size of the span at the end of the array.
+    size_type decode(size_type first, std::span<T> output) const
+    {
+        const auto total = size();
+        const auto count = first >= total ? 0 : (output.size() < total - first ? output.size() : total - first);
+
+        size_type written = 0;
+        while (written < count)
+        {
+            const auto index  = first + written;
+            const auto block  = index / block_size;
+            const auto offset = index % block_size;
+            const auto length = block_size - offset < count - written ? block_size - offset : count - written;
+
+            if (block == block_count())
+            {
+                std::memcpy(output.data() + written, m_pending.data() + offset, length * sizeof(T));
+            }
+            else if (length == block_size)
+            {
+                decode_block(block, output.data() + written);
+            }
+            else
+            {
+                T buffer[block_size];
+                decode_block(block, buffer);
+                std::memcpy(output.data() + written, buffer + offset, length * sizeof(T));
+            }
+            written += length;
+        }
+        return count;
+    }
+
+    /// @brief Remove all values from the array.
+    void clear()
+    {
+        m_bytes.clear();
+        m_block_offsets.clear();
+        m_pending_size = 0;
+    }
+
+    /// @brief Get the number of values in the array.
+    [[nodiscard]] size_type size() const
+    {
+        return block_count() * block_size + m_pending_size;
+    }
+
+    /// @brief True if the array holds no values, else false.
+    [[nodiscard]] bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// @brief Get the number of compressed blocks.
+    [[nodiscard]] size_type block_count() const
+    {
+        return m_block_offsets.size();
+    }
+
+    /// @brief Get the number of bytes used for storing the values: the compressed blocks, the block index and the
+    /// uncompressed values of the last block.
+    [[nodiscard]] size_type size_bytes() const
+    {
+        return m_bytes.size() + m_block_offsets.size() * sizeof(usz) + m_pending_size * sizeof(T);
+    }
+
+  private:
+    struct block_header
+    {
+        array<word_type, lane_count> starts;
+        word_type reference;
+        u32 bit_width;
+        const u8 *payload;
+    };
+
+    // the number of bit packed rows of every block, i.e. all rows but the first.
+    static constexpr usz packed_rows = lane_length - 1;
+
+    // zero bytes behind the last block, so that decoding may always load the row after the current one.
+    static constexpr usz padding_size = 32;
+
+    [[nodiscard]] static constexpr word_type width_mask(u32 bit_width)
+    {
+        return bit_width >= word_bits ? static_cast<word_type>(~word_type{0})
+                                      : static_cast<word_type>((word_type{1} << bit_width) - 1);
+    }
+
+    [[nodiscard]] static constexpr usz payload_words(u32 bit_width)
+    {
+        return (packed_rows * bit_width + word_bits - 1) / word_bits * lane_count;
+    }
+
+    [[nodiscard]] static word_type load_word(const u8 *payload, usz index)
+    {
+        word_type word;
+        std::memcpy(&word, payload + index * sizeof(word_type), sizeof(word_type));
+        return word;
+    }
+
+    [[nodiscard]] static constexpr u64 to_varint(word_type value)
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            return detail::zigzag_encode(static_cast<T>(value));
+        }
+        else
+        {
+            return value;
+        }
+    }
+
+    [[nodiscard]] static constexpr word_type from_varint(u64 value)
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            return static_cast<word_type>(detail::zigzag_decode(value));
+        }
+        else
+        {
+            return static_cast<word_type>(value);
+        }
+    }
+
+    [[nodiscard]] static constexpr s64 to_signed(word_type value)
+    {
+        return static_cast<std::make_signed_t<word_type>>(value);
+    }
+
+    [[nodiscard]] block_header read_header(usz block) const
+    {
+        block_header header;
+        const auto *input = m_bytes.data() + m_block_offsets[block];
+
+        header.starts[0] = from_varint(detail::varint_decode(input));
+        for (usz lane = 1; lane < lane_count; ++lane)
+        {
+            const auto difference = static_cast<word_type>(detail::zigzag_decode(detail::varint_decode(input)));
+            header.starts[lane]   = static_cast<word_type>(header.starts[0] + difference);
+        }
+        header.reference = static_cast<word_type>(detail::zigzag_decode(detail::varint_decode(input)));
+        header.bit_width = static_cast<u32>(*input++);
+        header.payload   = input;
+        return header;
+    }
+
+    void encode_block(const T *values)
+    {
+        const auto first = static_cast<word_type>(values[0]);
+
+        // the first row is stored in the header, as varint differences to the first value.
+        // drop the padding behind the previous block, it is added back behind this block.
+        m_bytes.resize(m_bytes.size() - (m_bytes.empty() ? 0 : padding_size));
+        m_block_offsets.push_back(m_bytes.size());
+        detail::varint_encode(to_varint(first), m_bytes);
+        for (usz lane = 1; lane < lane_count; ++lane)
+        {
+            const auto difference = static_cast<word_type>(static_cast<word_type>(values[lane]) - first);
+            detail::varint_encode(detail::zigzag_encode(to_signed(difference)), m_bytes);
+        }
+
+        // every other value is stored as the difference to the value one row, i.e. lane_count positions, before it.
+        word_type offsets[packed_rows * lane_count];
+        for (usz i = 0; i < packed_rows * lane_count; ++i)
+        {
+            offsets[i] = static_cast<word_type>(static_cast<word_type>(values[i + lane_count]) -
+                                                static_cast<word_type>(values[i]));
+        }
+
+        auto reference = to_signed(offsets[0]);
+        for (const auto offset : offsets)
+        {
+            reference = to_signed(offset) < reference ? to_signed(offset) : reference;
+        }
+        word_type max_offset = 0;
+        for (auto &offset : offsets)
+        {
+            offset     = static_cast<word_type>(offset - static_cast<word_type>(reference));
+            max_offset = offset > max_offset ? offset : max_offset;
+        }
+        const auto bit_width = static_cast<u32>(std::bit_width(max_offset));
+
+        detail::varint_encode(detail::zigzag_encode(reference), m_bytes);
+        m_bytes.push_back(static_cast<u8>(bit_width));
+
+        // the j-th offset of every lane goes to the same bit position of that lane's words, and word k of all lanes
+        // is stored consecutively.
+        word_type words[block_size] = {};
+        for (usz j = 0; j < packed_rows; ++j)
+        {
+            const auto bit   = j * bit_width;
+            const auto word  = bit / word_bits;
+            const auto shift = static_cast<u32>(bit % word_bits);
+            for (usz lane = 0; lane < lane_count; ++lane)
+            {
+                const auto offset = offsets[j * lane_count + lane];
+                words[word * lane_count + lane] |= static_cast<word_type>(offset << shift);
+                if (shift + bit_width > word_bits)
+                {
+                    words[(word + 1) * lane_count + lane] |= static_cast<word_type>(offset >> (word_bits - shift));
+                }
+            }
+        }
+
+        const auto payload_size = payload_words(bit_width) * sizeof(word_type);
+        const auto position     = m_bytes.size();
+        m_bytes.resize(position + payload_size + padding_size);
+        std::memcpy(m_bytes.data() + position, words, payload_size);
+    }
+
+    void decode_block(usz block, T *output) const
+    {
+        const auto header = read_header(block);
+        for (usz lane = 0; lane < lane_count; ++lane)
+        {
+            output[lane] = static_cast<T>(header.starts[lane]);
+        }
+        output += lane_count;
+
+        if (header.bit_width == 0)
+        {
+            // every offset is zero and nothing is packed.
+            auto previous = header.starts;
+            for (usz j = 0; j < packed_rows; ++j)
+            {
+                for (usz lane = 0; lane < lane_count; ++lane)
+                {
+                    previous[lane]                = static_cast<word_type>(previous[lane] + header.reference);
+                    output[j * lane_count + lane] = static_cast<T>(previous[lane]);
+                }
+            }
+            return;
+        }
+
+#if QZ_DELTA_ARRAY_SIMD
+        if constexpr (sizeof(word_type) == 4 || sizeof(word_type) == 8)
+        {
+            // a row of lanes takes one AVX2 register, or two SSE2 registers.
+            using lanes                   = detail::simd_lanes<sizeof(word_type)>;
+            using register_type           = typename lanes::register_type;
+            constexpr auto register_count = 32 / lanes::register_size;
+
+            const auto mask      = lanes::broadcast(width_mask(header.bit_width));
+            const auto reference = lanes::broadcast(header.reference);
+            register_type previous[register_count];
+            for (usz r = 0; r < register_count; ++r)
+            {
+                previous[r] = lanes::load(header.starts.data() + r * lanes::register_size / sizeof(word_type));
+            }
+
+            for (usz j = 0; j < packed_rows; ++j)
+            {
+                const auto bit   = j * header.bit_width;
+                const auto word  = bit / word_bits;
+                const auto shift = static_cast<u32>(bit % word_bits);
+
+                // branch free: shifting left by word_bits yields zero, and without a spill the bits shifted in from the
+                // next row land above the bit width and are masked off.
+                for (usz r = 0; r < register_count; ++r)
+                {
+                    const auto *source = header.payload + word * 32 + r * lanes::register_size;
+                    const auto low     = lanes::shift_right(lanes::load(source), shift);
+                    const auto high    = lanes::shift_left(lanes::load(source + 32), word_bits - shift);
+                    const auto offsets = lanes::bit_and(lanes::bit_or(low, high), mask);
+                    previous[r]        = lanes::add(previous[r], lanes::add(reference, offsets));
+                    lanes::store(output + j * lane_count + r * lanes::register_size / sizeof(word_type), previous[r]);
+                }
+            }
+            return;
+        }
+#endif
+
+        const auto mask = width_mask(header.bit_width);
+        auto previous   = header.starts;
+        for (usz j = 0; j < packed_rows; ++j)
+        {
+            const auto bit   = j * header.bit_width;
+            const auto word  = bit / word_bits;
+            const auto shift = static_cast<u32>(bit % word_bits);
+
+            // every lane runs its own prefix sum, so all lanes advance at once. the high word is shifted in two
+            // steps, so that a shift of zero yields zero instead of being undefined.
+            for (usz lane = 0; lane < lane_count; ++lane)
+            {
+                const auto low    = load_word(header.payload, word * lane_count + lane);
+                const auto high   = load_word(header.payload, (word + 1) * lane_count + lane);
+                const auto offset = static_cast<word_type>((low >> shift) | ((high << 1) << (word_bits - 1 - shift)));
+                previous[lane] = static_cast<word_type>(previous[lane] + header.reference + (offset & mask));
+                output[j * lane_count + lane] = static_cast<T>(previous[lane]);
+            }
+        }
+    }
+
+    std::vector<u8> m_bytes;
+    std::vector<usz> m_block_offsets;
+    array<T, block_size> m_pending{};
+    usz m_pending_size = 0;
+};
+
+} // namespace qz
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "quartz/assert.hpp"
+#include "quartz/hardware.hpp"
+#include "quartz/sync.hpp"
+#include "quartz/types.hpp"
+#include "quartz/utilities.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzEpoch Epoch-based reclamation
+/// @brief Safe memory reclamation for data which is read concurrently without locks, and replaced rarely.
+/// @details Readers pin an epoch while they access shared objects, and writers retire the objects they unlink instead
+/// of deleting them. A retired object is deleted once every reader which could still see it has unpinned. Include
+/// <quartz/epoch.hpp> to use these features.
+/// @{
+///
+
+///
+/// @brief An epoch-based reclamation domain.
+/// @details The domain keeps a global epoch counter and an array of cache line sized slots, in which readers record the
+/// epoch they have pinned. A thread uses the slot picked by qz::this_thread_index(), so with at least as many slots as
+/// reading threads, pinning is a single atomic increment on a cache line which other readers never touch, and readers
+/// scale with the number of cores. Threads which share a slot remain correct, but contend on that slot.
+///
+/// Retired objects are tagged with the epoch at which they were retired, and collected in a list. The epoch advances
+/// only when every pinned reader has observed the current epoch, so an object retired at epoch `e` can no longer be
+/// reachable by any reader once the epoch reaches `e + 2`. Retired objects are freed in batches, whenever another
+/// reclaim_threshold entries have been added to the list, or when reclaim() is called.
+///
+/// @note A thread must not call synchronize() while it has an epoch pinned, since it would wait for itself. No thread
+/// may be pinned when the domain is destroyed.
+///
+class epoch
+{
+  public:
+    class guard;
+
+    /// @brief The number of objects retired since the last attempt to free them, which triggers another attempt.
+    static constexpr usz reclaim_threshold = 64;
+
+    // CONSTRUCTORS
+
+    /// @brief Construct a domain with the given number of slots. Ideally one slot per reading thread.
+    explicit epoch(usz slot_count = 64);
+
+    epoch(const epoch &)            = delete;
+    epoch &operator=(const epoch &) = delete;
+
+    /// @brief Free all retired objects, regardless of their epoch.
+    ~epoch();
+
+    /// @brief Get the domain shared by the whole process, used by default by qz::rcu_ptr.
+    [[nodiscard]] static epoch &global();
+
+    // METHODS
+
+    /// @brief Pin the current epoch for the calling thread, until the returned guard is destroyed.
+    /// @details Objects reachable while the guard is alive will not be freed before it is destroyed. Guards may be
+    /// nested.
+    [[nodiscard]] guard pin();
+
+    /// @brief Retire an object, which is destroyed by the given deleter once no reader can be using it anymore.
+    /// @details Must be called after the object has been unlinked from every shared location readers load it from.
+    void retire(void *object, void (*deleter)(void *));
+
+    /// @brief Retire an object allocated with `new`, which is deleted once no reader can be using it anymore.
+    template <class T>
+    void retire(T *object)
+    {
+        retire(const_cast<std::remove_cv_t<T> *>(object), [](void *pointer) { delete static_cast<T *>(pointer); });
+    }
+
+    /// @brief Try to advance the epoch, and free the retired objects which are no longer reachable by any reader.
+    /// @return The number of objects freed.
+    usz reclaim();
+
+    /// @brief Wait until every object retired before the call has been freed.
+    void synchronize();
+
+    /// @brief Get the current epoch.
+    [[nodiscard]] u64 current() const
+    {
+        return m_epoch.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Get the number of retired objects which have not been freed yet.
+    [[nodiscard]] usz pending() const;
+
+    /// @brief Get the number of slots.
+    [[nodiscard]] usz slot_count() const
+    {
+        return m_slot_count;
+    }
+
+  private:
+    struct retired
+    {
+        void *object;
+        void (*deleter)(void *);
+        u64 retired_at;
+    };
+
+    // a slot holds the number of guards pinned through it in the low bits, and an epoch in the high bits. The epoch of
+    // a pinned slot may be older than the epoch at the time of pinning, which only holds back reclamation for a little
+    // longer. try_advance() brings the epochs of idle slots up to date.
+    static constexpr u64 count_bits = 24;
+    static constexpr u64 count_mask = (u64{1} << count_bits) - 1;
+
+    // advances the epoch if every pinned slot has observed it, and returns the resulting epoch. Requires the lock.
+    u64 try_advance();
+
+    std::atomic<u64> m_epoch = 1;
+    usz m_slot_count;
+    std::unique_ptr<cache_padded<std::atomic<u64>>[]> m_slots;
+
+    mutable mutex m_lock;
+    std::vector<retired> m_retired;
+    usz m_reclaim_at = reclaim_threshold;
+};
+
+///
+/// @brief An RAII guard keeping an epoch pinned for the calling thread.
+/// @details Obtained from qz::epoch::pin(). Must be destroyed on the thread that created it.
+///
+class epoch::guard
+{
+  public:
+    guard(guard &&other) noexcept : m_slot(other.m_slot)
+    {
+        other.m_slot = nullptr;
+    }
+
+    guard(const guard &)            = delete;
+    guard &operator=(const guard &) = delete;
+    guard &operator=(guard &&)      = delete;
+
+    ~guard()
+    {
+        if (m_slot != nullptr)
+        {
+            m_slot->fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+  private:
+    friend class epoch;
+
+    explicit guard(std::atomic<u64> *slot) : m_slot(slot)
+    {
+    }
+
+    std::atomic<u64> *m_slot;
+};
+
+inline epoch::guard epoch::pin()
+{
+    auto &slot = m_slots[this_thread_index() % m_slot_count].value;
+
+    // the sequentially consistent increment orders the pin before every later load of a shared pointer, against the
+    // unlinking of retired objects and the slot scans of try_advance().
+    u64 state = slot.fetch_add(1, std::memory_order_seq_cst);
+    QZ_ASSERT_MSG((state & count_mask) != count_mask, "Too many guards pinned through a single epoch slot.");
+
+    // the first guard of a slot brings its epoch up to date, so that a busy reader does not hold back reclamation. If
+    // another guard was pinned in the meantime the slot keeps the older epoch.
+    const u64 current = m_epoch.load(std::memory_order_seq_cst) << count_bits;
+    if ((state & count_mask) == 0 && (state & ~count_mask) != current)
+    {
+        ++state;
+        slot.compare_exchange_strong(state, current | 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+    return guard(&slot);
+}
+
+///
+/// @brief An owning pointer to an object which is read without locking, and replaced by publishing a new object.
+/// @details Reading pins the epoch of the domain and loads the pointer, which writes only to the epoch slot of the
+/// reading thread and never blocks. Replacing the object publishes the new one with a single atomic exchange and
+/// retires the old one, which is freed once the readers that may still see it have finished. Writers never wait for
+/// readers, and concurrent writers are resolved by the order of their exchanges, or retried for update().
+///
+/// @tparam T The type of the object. Readers only get const access to it.
+///
+template <class T>
+class rcu_ptr
+{
+  public:
+    ///
+    /// @brief A pinned view of the object of a qz::rcu_ptr, which stays valid while the view is alive.
+    ///
+    class reader
+    {
+      public:
+        /// @brief Get the object, which may be null if the pointer was empty.
+        [[nodiscard]] const T *get() const
+        {
+            return m_object;
+        }
+
+        /// @brief Check whether the pointer held an object.
+        explicit operator bool() const
+        {
+            return m_object != nullptr;
+        }
+
+        const T &operator*() const
+        {
+            QZ_ASSERT_MSG(m_object != nullptr, "Cannot dereference an empty qz::rcu_ptr.");
+            return *m_object;
+        }
+
+        const T *operator->() const
+        {
+            QZ_ASSERT_MSG(m_object != nullptr, "Cannot dereference an empty qz::rcu_ptr.");
+            return m_object;
+        }
+
+      private:
+        friend class rcu_ptr;
+
+        reader(epoch::guard guard, const T *object) : m_guard(qz::move(guard)), m_object(object)
+        {
+        }
+
+        epoch::guard m_guard;
+        const T *m_object;
+    };
+
+    // CONSTRUCTORS
+
+    /// @brief Construct an empty pointer.
+    explicit rcu_ptr(epoch &domain = epoch::global()) : m_domain(&domain)
+    {
+    }
+
+    /// @brief Construct a pointer owning the given object.
+    explicit rcu_ptr(std::unique_ptr<T> object, epoch &domain = epoch::global())
+        : m_domain(&domain), m_object(object.release())
+    {
+    }
+
+    rcu_ptr(const rcu_ptr &)            = delete;
+    rcu_ptr &operator=(const rcu_ptr &) = delete;
+
+    /// @brief Retire the owned object, as readers may still be using it.
+    ~rcu_ptr()
+    {
+        if (auto *object = m_object.load(std::memory_order_relaxed))
+        {
+            m_domain->retire(object);
+        }
+    }
+
+    // METHODS
+
+    /// @brief Pin the epoch and get a view of the current object.
+    [[nodiscard]] reader read() const
+    {
+        auto guard = m_domain->pin();
+        return reader(qz::move(guard), m_object.load(std::memory_order_seq_cst));
+    }
+
+    /// @brief Get the current object under a guard which the caller already holds.
+    /// @details Useful for reading several pointers of the same domain with a single pin. The object stays valid
+    /// while the guard is alive.
+    [[nodiscard]] const T *load(const epoch::guard & /* pinned */) const
+    {
+        return m_object.load(std::memory_order_seq_cst);
+    }
+
+    /// @brief Publish a new object, and retire the previous one.
+    void store(std::unique_ptr<T> object)
+    {
+        if (auto *previous = m_object.exchange(object.release(), std::memory_order_seq_cst))
+        {
+            m_domain->retire(previous);
+        }
+    }
+
+    /// @brief Construct a new object in place, publish it, and retire the previous one.
+    template <class... Args>
+    void emplace(Args &&...args)
+    {
+        store(std::make_unique<T>(static_cast<Args &&>(args)...));
+    }
+
+    /// @brief Publish a modified copy of the current object, and retire the previous one.
+    /// @details The function is applied to a copy of the current object, which is then published if the object has
+    /// not been replaced in the meantime. Otherwise the copy is discarded, and the update is retried on the newer
+    /// object. The pointer must not be empty.
+    /// @param function The callable modifying the copy, taking a `T &`.
+    template <class Function>
+    void update(Function &&function)
+    {
+        auto guard    = m_domain->pin();
+        auto *current = m_object.load(std::memory_order_seq_cst);
+        for (;;)
+        {
+            QZ_ASSERT_MSG(current != nullptr, "Cannot update an empty qz::rcu_ptr.");
+            auto copy = std::make_unique<T>(*current);
+            function(*copy);
+            if (m_object.compare_exchange_strong(current, copy.get(), std::memory_order_seq_cst))
+            {
+                copy.release();
+                m_domain->retire(current);
+                return;
+            }
+        }
+    }
+
+    /// @brief Get the domain the retired objects are handed to.
+    [[nodiscard]] epoch &domain() const
+    {
+        return *m_domain;
+    }
+
+  private:
+    epoch *m_domain;
+    std::atomic<T *> m_object = nullptr;
+};
+
+///
+/// @}
+///
+
+} // namespace qz
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "quartz/assert.hpp"
+#include "quartz/utilities.hpp"
+
+namespace qz
+{
+
+///
+/// @ingroup QzVocabulary
+///
+/// @brief A wrapper marking a value as the error of a qz::expected.
+/// @tparam E The error type.
+///
+template <class E>
+class unexpected
+{
+  public:
+    /// @brief Construct the wrapper from the given error.
+    template <class U = E>
+        requires(std::is_constructible_v<E, U &&> && !std::is_same_v<std::remove_cvref_t<U>, unexpected>)
+    constexpr explicit unexpected(U &&error) : m_error(static_cast<U &&>(error))
+    {
+    }
+
+    /// @brief Get a reference to the error.
+    [[nodiscard]] constexpr E &error() &
+    {
+        return m_error;
+    }
+
+    /// @brief Get a const reference to the error.
+    [[nodiscard]] constexpr const E &error() const &
+    {
+        return m_error;
+    }
+
+    /// @brief Get an rvalue reference to the error.
+    [[nodiscard]] constexpr E &&error() &&
+    {
+        return qz::move(m_error);
+    }
+
+  private:
+    E m_error;
+};
+
+/// @brief Type deduction guide for qz::unexpected
+template <class E>
+unexpected(E) -> unexpected<E>;
+
+///
+/// @ingroup QzVocabulary
+///
+/// @brief Either a value or an error describing why the value could not be produced.
+/// @details An exception-free way of reporting recoverable failures. The value and the error share storage, and the
+/// expected is trivially copyable and destructible whenever both T and E are. Accessing the value of an expected
+/// holding an error through value() reports the failure through the assertion handler.
+///
+/// @tparam T The value type. May be `void` for operations which only report success or failure.
+/// @tparam E The error type.
+///
+template <class T, class E>
+class expected
+{
+    static constexpr bool is_void = std::is_void_v<T>;
+
+    // stand-in for the value of expected<void, E>.
+    struct empty_type
+    {
+    };
+
+    using storage_type = std::conditional_t<is_void, empty_type, T>;
+
+    static constexpr bool copy_constructible =
+        std::is_copy_constructible_v<storage_type> && std::is_copy_constructible_v<E>;
+    static constexpr bool copy_assignable =
+        copy_constructible && std::is_copy_assignable_v<storage_type> && std::is_copy_assignable_v<E>;
+    static constexpr bool move_constructible =
+        std::is_move_constructible_v<storage_type> && std::is_move_constructible_v<E>;
+    static constexpr bool move_assignable =
+        move_constructible && std::is_move_assignable_v<storage_type> && std::is_move_assignable_v<E>;
+    static constexpr bool trivially_copy_constructible =
+        std::is_trivially_copy_constructible_v<storage_type> && std::is_trivially_copy_constructible_v<E>;
+    static constexpr bool trivially_move_constructible =
+        std::is_trivially_move_constructible_v<storage_type> && std::is_trivially_move_constructible_v<E>;
+    static constexpr bool trivially_destructible =
+        std::is_trivially_destructible_v<storage_type> && std::is_trivially_destructible_v<E>;
+    static constexpr bool trivially_copy_assignable = trivially_copy_constructible && trivially_destructible &&
+                                                      std::is_trivially_copy_assignable_v<storage_type> &&
+                                                      std::is_trivially_copy_assignable_v<E>;
+    static constexpr bool trivially_move_assignable = trivially_move_constructible && trivially_destructible &&
+                                                      std::is_trivially_move_assignable_v<storage_type> &&
+                                                      std::is_trivially_move_assignable_v<E>;
+
+  public:
+    using value_type      = T;
+    using error_type      = E;
+    using unexpected_type = unexpected<E>;
+
+    // CONSTRUCTORS & DESTRUCTOR
+
+    /// @brief Construct an expected holding a value initialized value.
+    constexpr expected()
+        requires(std::is_default_constructible_v<storage_type>)
+        : m_value(), m_has_value(true)
+    {
+    }
+
+    /// @brief Construct an expected holding the given value.
+    template <class U = storage_type>
+        requires(!is_void && std::is_constructible_v<storage_type, U &&> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, expected> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, unexpected<E>>)
+    constexpr expected(U &&value) // NOLINT (implicit conversion)
+        : m_value(static_cast<U &&>(value)), m_has_value(true)
+    {
+    }
+
+    /// @brief Construct an expected holding the given error.
+    template <class G>
+        requires(std::is_constructible_v<E, const G &>)
+    constexpr expected(const unexpected<G> &error) // NOLINT (implicit conversion)
+        : m_error(error.error()), m_has_value(false)
+    {
+    }
+
+    /// @brief Construct an expected holding the given error.
+    template <class G>
+        requires(std::is_constructible_v<E, G &&>)
+    constexpr expected(unexpected<G> &&error) // NOLINT (implicit conversion)
+        : m_error(qz::move(error).error()), m_has_value(false)
+    {
+    }
+
+    constexpr expected(const expected &other)
+        requires(trivially_copy_constructible)
+    = default;
+
+    constexpr expected(const expected &other)
+        requires(copy_constructible && !trivially_copy_constructible)
+        : m_empty(), m_has_value(other.m_has_value)
+    {
+        construct_from(other);
+    }
+
+    constexpr expected(expected &&other) noexcept
+        requires(trivially_move_constructible)
+    = default;
+
+    constexpr expected(expected &&other) noexcept(std::is_nothrow_move_constructible_v<storage_type> &&
+                                                  std::is_nothrow_move_constructible_v<E>)
+        requires(move_constructible && !trivially_move_constructible)
+        : m_empty(), m_has_value(other.m_has_value)
+    {
+        construct_from(qz::move(other));
+    }
+
+    constexpr expected &operator=(const expected &other)
+        requires(trivially_copy_assignable)
+    = default;
+
+    constexpr expected &operator=(const expected &other)
+        requires(copy_assignable && !trivially_copy_assignable)
+    {
+        if (this != &other)
+        {
+            assign(other);
+        }
+        return *this;
+    }
+
+    constexpr expected &operator=(expected &&other) noexcept
+        requires(trivially_move_assignable)
+    = default;
+
+    constexpr expected &operator=(expected &&other) noexcept(
+        std::is_nothrow_move_constructible_v<storage_type> && std::is_nothrow_move_constructible_v<E> &&
+        std::is_nothrow_move_assignable_v<storage_type> && std::is_nothrow_move_assignable_v<E>)
+        requires(move_assignable && !trivially_move_assignable)
+    {
+        if (this != &other)
+        {
+            assign(qz::move(other));
+        }
+        return *this;
+    }
+
+    constexpr ~expected()
+        requires(trivially_destructible)
+    = default;
+
+    constexpr ~expected()
+    {
+        destroy();
+    }
+
+    // METHODS
+
+    /// @brief True if a value is present, false if an error is present.
+    [[nodiscard]] constexpr bool has_value() const
+    {
+        return m_has_value;
+    }
+
+    /// @brief Get a reference to the value. Reports an assertion failure if an error is present.
+    [[nodiscard]] constexpr decltype(auto) value()
+    {
+        QZ_VERIFY_MSG(m_has_value, "Accessing the value of an expected holding an error.");
+        if constexpr (!is_void)
+        {
+            return static_cast<T &>(m_value);
+        }
+    }
+
+    /// @brief Get a const reference to the value. Reports an assertion failure if an error is present.
+    [[nodiscard]] constexpr decltype(auto) value() const
+    {
+        QZ_VERIFY_MSG(m_has_value, "Accessing the value of an expected holding an error.");
+        if constexpr (!is_void)
+        {
+            return static_cast<const T &>(m_value);
+        }
+    }
+
+    /// @brief Get a copy of the value if present, else the given fallback value.
+    template <class U>
+        requires(!is_void)
+    [[nodiscard]] constexpr storage_type value_or(U &&fallback) const
+    {
+        return m_has_value ? m_value : static_cast<storage_type>(static_cast<U &&>(fallback));
+    }
+
+    /// @brief Get a reference to the error. Only checked in debug builds.
+    [[nodiscard]] constexpr E &error()
+    {
+        QZ_ASSERT_MSG(!m_has_value, "Accessing the error of an expected holding a value.");
+        return m_error;
+    }
+
+    /// @brief Get a const reference to the error. Only checked in debug builds.
+    [[nodiscard]] constexpr const E &error() const
+    {
+        QZ_ASSERT_MSG(!m_has_value, "Accessing the error of an expected holding a value.");
+        return m_error;
+    }
+
+    /// @brief Call the function with the value if present and return its result, else propagate the error.
+    /// @param fn The function, which must return a qz::expected with the same error type.
+    template <class F>
+    constexpr auto and_then(F &&fn) const
+    {
+        if constexpr (is_void)
+        {
+            using result_type = std::remove_cvref_t<std::invoke_result_t<F>>;
+            return m_has_value ? static_cast<F &&>(fn)() : result_type(unexpected<E>(m_error));
+        }
+        else
+        {
+            using result_type = std::remove_cvref_t<std::invoke_result_t<F, const T &>>;
+            return m_has_value ? static_cast<F &&>(fn)(m_value) : result_type(unexpected<E>(m_error));
+        }
+    }
+
+    /// @brief Call the function with the value if present and wrap its result, else propagate the error.
+    /// @param fn The function, whose result becomes the value of the returned qz::expected.
+    template <class F>
+        requires(!is_void)
+    constexpr auto transform(F &&fn) const
+    {
+        using result_type = expected<std::remove_cvref_t<std::invoke_result_t<F, const T &>>, E>;
+        return m_has_value ? result_type(static_cast<F &&>(fn)(m_value)) : result_type(unexpected<E>(m_error));
+    }
+
+    // OPERATOR OVERLOADS
+
+    /// @brief True if a value is present, false if an error is present.
+    [[nodiscard]] constexpr explicit operator bool() const
+    {
+        return m_has_value;
+    }
+
+    /// @brief Get a reference to the value. Only checked in debug builds.
+    [[nodiscard]] constexpr storage_type &operator*()
+        requires(!is_void)
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an expected holding an error.");
+        return m_value;
+    }
+
+    /// @brief Get a const reference to the value. Only checked in debug builds.
+    [[nodiscard]] constexpr const storage_type &operator*() const
+        requires(!is_void)
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an expected holding an error.");
+        return m_value;
+    }
+
+    /// @brief Access members of the value. Only checked in debug builds.
+    [[nodiscard]] constexpr storage_type *operator->()
+        requires(!is_void)
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an expected holding an error.");
+        return &m_value;
+    }
+
+    /// @brief Access members of the value. Only checked in debug builds.
+    [[nodiscard]] constexpr const storage_type *operator->() const
+        requires(!is_void)
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an expected holding an error.");
+        return &m_value;
+    }
+
+  private:
+    // assigns in place while the state stays the same, so a throwing assignment leaves a valid member behind.
+    template <class Other>
+    constexpr void assign(Other &&other)
+    {
+        if (m_has_value && other.m_has_value)
+        {
+            m_value = static_cast<Other &&>(other).m_value;
+        }
+        else if (!m_has_value && !other.m_has_value)
+        {
+            m_error = static_cast<Other &&>(other).m_error;
+        }
+        else if (other.m_has_value)
+        {
+            reinit(m_value, m_error, static_cast<Other &&>(other).m_value);
+            m_has_value = true;
+        }
+        else
+        {
+            reinit(m_error, m_value, static_cast<Other &&>(other).m_error);
+            m_has_value = false;
+        }
+    }
+
+    // replaces the old member of the union with a new one constructed from the argument. The new member is constructed
+    // before the old one is destroyed, or the old one is restored if that fails, so if constructing the new member
+    // throws, the expected still holds the old one.
+    template <class New, class Old, class Arg>
+    static constexpr void reinit(New &new_member, Old &old_member, Arg &&arg)
+    {
+        if constexpr (std::is_nothrow_constructible_v<New, Arg &&>)
+        {
+            std::destroy_at(&old_member);
+            std::construct_at(&new_member, static_cast<Arg &&>(arg));
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<New>)
+        {
+            New temporary(static_cast<Arg &&>(arg));
+            std::destroy_at(&old_member);
+            std::construct_at(&new_member, qz::move(temporary));
+        }
+        else
+        {
+            static_assert(std::is_nothrow_move_constructible_v<Old>,
+                          "Assigning a qz::expected needs a nothrow move constructible value or error type.");
+            Old saved(qz::move(old_member));
+            std::destroy_at(&old_member);
+#if defined(QZ_NO_EXCEPTIONS)
+            std::construct_at(&new_member, static_cast<Arg &&>(arg));
+#else
+            try
+            {
+                std::construct_at(&new_member, static_cast<Arg &&>(arg));
+            }
+            catch (...)
+            {
+                std::construct_at(&old_member, qz::move(saved));
+                throw;
+            }
+#endif
+        }
+    }
+
+    template <class Other>
+    constexpr void construct_from(Other &&other)
+    {
+        if (m_has_value)
+        {
+            std::construct_at(&m_value, static_cast<Other &&>(other).m_value);
+        }
+        else
+        {
+            std::construct_at(&m_error, static_cast<Other &&>(other).m_error);
+        }
+    }
+
+    constexpr void destroy()
+    {
+        if (m_has_value)
+        {
+            m_value.~storage_type();
+        }
+        else
+        {
+            m_error.~E();
+        }
+    }
+
+    union {
+        empty_type m_empty;
+        storage_type m_value;
+        E m_error;
+    };
+    bool m_has_value;
+};
+
+} // namespace qz
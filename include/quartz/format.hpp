@@ -0,0 +1,220 @@
+#pragma once
+
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <limits>
+#include <type_traits>
+
+#include "quartz/string.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+/// @cond Undocumented
+namespace detail
+{
+
+// two digit strings for every value in [0, 100), so that the digits of an integer are written two at a time.
+inline constexpr char digit_pairs[201] = "00010203040506070809"
+                                         "10111213141516171819"
+                                         "20212223242526272829"
+                                         "30313233343536373839"
+                                         "40414243444546474849"
+                                         "50515253545556575859"
+                                         "60616263646566676869"
+                                         "70717273747576777879"
+                                         "80818283848586878889"
+                                         "90919293949596979899";
+
+// powers of ten, except for the first entry which is zero so that count_digits(0) is 1.
+inline constexpr u64 digit_thresholds[20] = {
+    0,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000,
+    100000000000,
+    1000000000000,
+    10000000000000,
+    100000000000000,
+    1000000000000000,
+    10000000000000000,
+    100000000000000000,
+    1000000000000000000,
+    10000000000000000000ULL,
+};
+
+[[nodiscard]] constexpr u32 count_digits(u64 value)
+{
+    // 1233 / 4096 approximates log10(2), which under-estimates the digit count by at most one.
+    const auto estimate = (static_cast<u32>(std::bit_width(value | 1)) * 1233) >> 12;
+    return estimate + static_cast<u32>(value >= digit_thresholds[estimate]);
+}
+
+// writes the digits of the value backwards, ending right before the given position.
+constexpr void write_digits(char *end, u64 value)
+{
+    while (value >= 100)
+    {
+        const auto pair = static_cast<usz>(value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        end[0] = digit_pairs[pair];
+        end[1] = digit_pairs[pair + 1];
+    }
+    if (value >= 10)
+    {
+        const auto pair = static_cast<usz>(value) * 2;
+        end[-2]         = digit_pairs[pair];
+        end[-1]         = digit_pairs[pair + 1];
+    }
+    else
+    {
+        end[-1] = static_cast<char>('0' + value);
+    }
+}
+
+[[nodiscard]] constexpr usz count_decimal_digits(int value)
+{
+    usz count = 1;
+    for (; value >= 10; value /= 10)
+    {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace detail
+/// @endcond
+
+///
+/// @defgroup QzFormat Formatting
+/// @brief Functions for formatting numbers into caller provided buffers without allocating. Include
+/// <quartz/format.hpp> to use them.
+/// @{
+///
+
+///
+/// @brief Concept for the integer types accepted by qz::format_to. Excludes `bool` and `char`, which are not numbers.
+///
+template <class T>
+concept formattable_integer = std::integral<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>;
+
+///
+/// @brief The largest number of characters qz::format_to writes for a value of the given type, using the shortest
+/// representation for floating point types.
+///
+template <class T>
+    requires(formattable_integer<T> || std::floating_point<T>)
+inline constexpr usz max_formatted_size =
+    std::floating_point<T>
+        // sign, digits, decimal point, exponent marker, exponent sign & exponent digits.
+        ? 4 + std::numeric_limits<T>::max_digits10 +
+              detail::count_decimal_digits(std::numeric_limits<T>::max_exponent10)
+        : std::numeric_limits<T>::digits10 + 1 + std::is_signed_v<T>;
+
+///
+/// @brief Write the decimal representation of an integer into the buffer [first, last).
+/// @details Digits are produced two at a time from a table of digit pairs, into the exact number of characters
+/// needed, so no temporary buffer or reversal is involved. No null terminator is written.
+///
+/// @param first The start of the buffer.
+/// @param last The end of the buffer.
+/// @param value The integer.
+/// @return A pointer one past the last written character, or nullptr if the buffer is too small, in which case the
+/// contents of the buffer are unspecified.
+///
+template <formattable_integer T>
+constexpr char *format_to(char *first, char *last, T value)
+{
+    auto magnitude = static_cast<u64>(value);
+    if constexpr (std::is_signed_v<T>)
+    {
+        if (value < 0)
+        {
+            if (first == last)
+            {
+                return nullptr;
+            }
+            *first++  = '-';
+            magnitude = 0 - magnitude;
+        }
+    }
+
+    const auto digits = detail::count_digits(magnitude);
+    if (static_cast<usz>(last - first) < digits)
+    {
+        return nullptr;
+    }
+    detail::write_digits(first + digits, magnitude);
+    return first + digits;
+}
+
+///
+/// @brief Write the shortest decimal representation of a floating point value which round trips back to the same
+/// value into the buffer [first, last).
+/// @details Backed by `std::to_chars`, which implements the Ryu family of algorithms on the major standard libraries.
+/// Picks fixed or scientific notation, whichever is shorter. No null terminator is written.
+///
+/// @param first The start of the buffer.
+/// @param last The end of the buffer.
+/// @param value The floating point value.
+/// @return A pointer one past the last written character, or nullptr if the buffer is too small, in which case the
+/// contents of the buffer are unspecified.
+///
+template <std::floating_point T>
+char *format_to(char *first, char *last, T value)
+{
+    const auto [end, error] = std::to_chars(first, last, value);
+    return error == std::errc() ? end : nullptr;
+}
+
+///
+/// @brief Write the decimal representation of a floating point value with the given number of digits after the
+/// decimal point into the buffer [first, last).
+///
+/// @param first The start of the buffer.
+/// @param last The end of the buffer.
+/// @param value The floating point value.
+/// @param precision The number of digits after the decimal point.
+/// @return A pointer one past the last written character, or nullptr if the buffer is too small, in which case the
+/// contents of the buffer are unspecified.
+///
+template <std::floating_point T>
+char *format_to(char *first, char *last, T value, int precision)
+{
+    const auto [end, error] = std::to_chars(first, last, value, std::chars_format::fixed, precision);
+    return error == std::errc() ? end : nullptr;
+}
+
+///
+/// @brief Append the decimal representation of a number to the end of the string.
+/// @details Formats into a stack buffer first, so the string only allocates if the formatted number does not fit in
+/// its current capacity.
+///
+/// @param string The string being appended to.
+/// @param value The number.
+/// @return The string.
+///
+template <class Allocator, class T>
+    requires(formattable_integer<T> || std::floating_point<T>)
+basic_small_string<Allocator> &format_to(basic_small_string<Allocator> &string, T value)
+{
+    char buffer[max_formatted_size<T>];
+    const auto *end = format_to(buffer, buffer + max_formatted_size<T>, value);
+    return string.append({buffer, static_cast<usz>(end - buffer)});
+}
+
+///
+/// @}
+///
+
+} // namespace qz
@@ -0,0 +1,78 @@
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzHardware Hardware helpers
+/// @brief Constants and functions describing or interacting with the underlying processor.
+/// @details Include <quartz/hardware.hpp> to use these features.
+///
+/// @{
+///
+
+///
+/// @brief The assumed size of a cache line in bytes. Used for padding data accessed by multiple threads to avoid false
+/// sharing.
+///
+inline constexpr usz cache_line_size = 64;
+
+///
+/// @brief Hint the processor that the calling thread is inside a spin-wait loop.
+/// @details Expands to the `pause` instruction on x86 and the `yield` instruction on ARM, which lowers power usage and
+/// frees up execution resources for the sibling hyper-thread while spinning.
+///
+inline void cpu_pause()
+{
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#elif defined(_M_ARM64) || defined(_M_ARM)
+    __yield();
+#endif
+}
+
+/// @cond Undocumented
+namespace detail
+{
+
+u32 allocate_thread_index();
+
+inline thread_local const u32 t_thread_index = allocate_thread_index(); // NOLINT
+
+} // namespace detail
+/// @endcond
+
+///
+/// @brief Get a small integer identifying the calling thread.
+/// @details Threads are numbered in the order they first call this function, starting at zero. Used for spreading
+/// threads over per-thread shards of a data structure. Indices are not reused after a thread exits.
+///
+[[nodiscard]] inline u32 this_thread_index()
+{
+    return detail::t_thread_index;
+}
+
+///
+/// @brief A wrapper which places its value on a cache line of its own.
+/// @tparam T The type of the wrapped value.
+///
+template <class T>
+struct alignas(cache_line_size) cache_padded
+{
+    /// @brief The wrapped value. Made public to allow aggregate initialization.
+    T value;
+};
+
+///
+/// @}
+///
+
+} // namespace qz
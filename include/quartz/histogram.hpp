@@ -0,0 +1,291 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+
+#include "quartz/array.hpp"
+#include "quartz/hardware.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzHistogram Latency histograms
+/// @brief Histograms for recording latencies and querying their percentiles. Include <quartz/histogram.hpp> to use
+/// them.
+/// @{
+///
+
+///
+/// @brief A log-linear histogram of 64-bit values, covering the full u64 range with a bounded relative error.
+/// @details Values are bucketed HDR-style: every power of two range is split into 32 equally sized sub-buckets, so a
+/// recorded value is off by at most 1/32 (~3%) of itself, and values below 64 are recorded exactly. The bucket counts
+/// take 15 KB and never allocate. Histograms are plain values which may be merged, which makes them suitable as
+/// snapshots of a qz::latency_recorder.
+///
+class latency_histogram
+{
+  public:
+    /// @brief The number of bits used for the linear sub-buckets of every power of two range.
+    static constexpr u32 sub_bucket_bits = 5;
+    /// @brief The number of linear sub-buckets of every power of two range.
+    static constexpr u32 sub_bucket_count = 1U << sub_bucket_bits;
+    /// @brief The total number of buckets.
+    static constexpr usz bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    // METHODS
+
+    /// @brief Get the index of the bucket the value is recorded in.
+    [[nodiscard]] static constexpr usz bucket_index(u64 value)
+    {
+        if (value < sub_bucket_count)
+        {
+            return static_cast<usz>(value);
+        }
+        const auto exponent = static_cast<u32>(std::bit_width(value)) - 1 - sub_bucket_bits;
+        return (static_cast<usz>(exponent) << sub_bucket_bits) + static_cast<usz>(value >> exponent);
+    }
+
+    /// @brief Get the smallest value recorded in the given bucket.
+    [[nodiscard]] static constexpr u64 bucket_lower_bound(usz index)
+    {
+        if (index < 2 * sub_bucket_count)
+        {
+            return index;
+        }
+        const auto exponent = static_cast<u32>(index >> sub_bucket_bits) - 1;
+        return static_cast<u64>(index - (static_cast<usz>(exponent) << sub_bucket_bits)) << exponent;
+    }
+
+    /// @brief Get the largest value recorded in the given bucket.
+    [[nodiscard]] static constexpr u64 bucket_upper_bound(usz index)
+    {
+        return bucket_lower_bound(index + 1) - 1; // wraps around to the maximum u64 for the last bucket.
+    }
+
+    /// @brief Record a value the given number of times.
+    constexpr void record(u64 value, u64 count = 1)
+    {
+        m_counts[bucket_index(value)] += count;
+        m_total += count;
+        m_sum += value * count;
+        m_min = value < m_min ? value : m_min;
+        m_max = value > m_max ? value : m_max;
+    }
+
+    /// @brief Record a duration, in nanoseconds.
+    template <class Rep, class Period>
+    constexpr void record(std::chrono::duration<Rep, Period> duration)
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        record(ns > 0 ? static_cast<u64>(ns) : 0);
+    }
+
+    /// @brief Add all values recorded in the other histogram to this histogram.
+    constexpr void merge(const latency_histogram &other)
+    {
+        for (usz i = 0; i < bucket_count; ++i)
+        {
+            m_counts[i] += other.m_counts[i];
+        }
+        m_total += other.m_total;
+        m_sum += other.m_sum;
+        m_min = other.m_min < m_min ? other.m_min : m_min;
+        m_max = other.m_max > m_max ? other.m_max : m_max;
+    }
+
+    /// @brief Remove all recorded values.
+    constexpr void reset()
+    {
+        *this = latency_histogram();
+    }
+
+    /// @brief Get the value at the given percentile.
+    /// @param percentile The percentile in the range [0, 100].
+    /// @return The largest value equivalent to the value at the percentile, i.e. the upper bound of its bucket clamped
+    /// to max(). Zero if the histogram is empty.
+    [[nodiscard]] constexpr u64 percentile(f64 percentile) const
+    {
+        if (m_total == 0)
+        {
+            return 0;
+        }
+        if (percentile <= 0.0)
+        {
+            return m_min;
+        }
+
+        const auto total      = static_cast<f64>(m_total);
+        const auto exact_rank = percentile >= 100.0 ? total : percentile / 100.0 * total;
+        auto rank             = static_cast<u64>(exact_rank);
+        rank += static_cast<u64>(static_cast<f64>(rank) < exact_rank); // round up.
+        rank = rank == 0 ? 1 : rank;
+
+        u64 cumulative = 0;
+        for (usz i = 0; i < bucket_count; ++i)
+        {
+            cumulative += m_counts[i];
+            if (cumulative >= rank)
+            {
+                const auto upper = bucket_upper_bound(i);
+                return upper < m_max ? upper : m_max;
+            }
+        }
+        return m_max;
+    }
+
+    /// @brief Get the number of recorded values.
+    [[nodiscard]] constexpr u64 count() const
+    {
+        return m_total;
+    }
+
+    /// @brief Get the number of values recorded in the given bucket.
+    [[nodiscard]] constexpr u64 count_at(usz index) const
+    {
+        return m_counts[index];
+    }
+
+    /// @brief Get the smallest recorded value. Zero if the histogram is empty.
+    [[nodiscard]] constexpr u64 min() const
+    {
+        return m_total == 0 ? 0 : m_min;
+    }
+
+    /// @brief Get the largest recorded value.
+    [[nodiscard]] constexpr u64 max() const
+    {
+        return m_max;
+    }
+
+    /// @brief Get the arithmetic mean of the recorded values. Zero if the histogram is empty.
+    [[nodiscard]] constexpr f64 mean() const
+    {
+        return m_total == 0 ? 0.0 : static_cast<f64>(m_sum) / static_cast<f64>(m_total);
+    }
+
+    /// @brief Add all values recorded in the other histogram to this histogram.
+    constexpr latency_histogram &operator+=(const latency_histogram &other)
+    {
+        merge(other);
+        return *this;
+    }
+
+  private:
+    friend class latency_recorder;
+
+    array<u64, bucket_count> m_counts{};
+    u64 m_total = 0;
+    u64 m_sum   = 0;
+    u64 m_min   = ~u64{0};
+    u64 m_max   = 0;
+};
+
+///
+/// @brief A latency histogram which may be recorded into from many threads at once without locking.
+/// @details Recording goes to one of several shards, picked by qz::this_thread_index(), so threads rarely touch the
+/// same cache lines. Each record() is a handful of relaxed atomic operations on the calling thread's shard. snapshot()
+/// sums up the shards into a qz::latency_histogram, and may be called concurrently with recording.
+///
+class latency_recorder
+{
+  public:
+    /// @brief Construct a recorder with the given number of shards. Ideally one shard per recording thread.
+    explicit latency_recorder(usz shard_count = 8)
+        : m_shard_count(shard_count == 0 ? 1 : shard_count), m_shards(std::make_unique<shard[]>(m_shard_count))
+    {
+    }
+
+    /// @brief Record a value.
+    void record(u64 value) noexcept
+    {
+        auto &shard = m_shards[this_thread_index() % m_shard_count];
+        shard.counts[latency_histogram::bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.total.fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+        // min & max rarely change, so the common case is a plain load.
+        auto min = shard.min.load(std::memory_order_relaxed);
+        while (value < min && !shard.min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+        {
+        }
+        auto max = shard.max.load(std::memory_order_relaxed);
+        while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// @brief Record a duration, in nanoseconds.
+    template <class Rep, class Period>
+    void record(std::chrono::duration<Rep, Period> duration) noexcept
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        record(ns > 0 ? static_cast<u64>(ns) : 0);
+    }
+
+    /// @brief Get a histogram of all values recorded so far.
+    [[nodiscard]] latency_histogram snapshot() const
+    {
+        latency_histogram result;
+        for (usz i = 0; i < m_shard_count; ++i)
+        {
+            const auto &shard = m_shards[i];
+            for (usz j = 0; j < latency_histogram::bucket_count; ++j)
+            {
+                result.m_counts[j] += shard.counts[j].load(std::memory_order_relaxed);
+            }
+            result.m_total += shard.total.load(std::memory_order_relaxed);
+            result.m_sum += shard.sum.load(std::memory_order_relaxed);
+            const auto min = shard.min.load(std::memory_order_relaxed);
+            const auto max = shard.max.load(std::memory_order_relaxed);
+            result.m_min   = min < result.m_min ? min : result.m_min;
+            result.m_max   = max > result.m_max ? max : result.m_max;
+        }
+        return result;
+    }
+
+    /// @brief Remove all recorded values. Values recorded concurrently with resetting may be partially lost.
+    void reset() noexcept
+    {
+        for (usz i = 0; i < m_shard_count; ++i)
+        {
+            auto &shard = m_shards[i];
+            for (auto &count : shard.counts)
+            {
+                count.store(0, std::memory_order_relaxed);
+            }
+            shard.total.store(0, std::memory_order_relaxed);
+            shard.sum.store(0, std::memory_order_relaxed);
+            shard.min.store(~u64{0}, std::memory_order_relaxed);
+            shard.max.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Get the number of shards.
+    [[nodiscard]] usz shard_count() const
+    {
+        return m_shard_count;
+    }
+
+  private:
+    struct alignas(cache_line_size) shard
+    {
+        std::atomic<u64> counts[latency_histogram::bucket_count] = {};
+        std::atomic<u64> total = 0;
+        std::atomic<u64> sum   = 0;
+        std::atomic<u64> min   = ~u64{0};
+        std::atomic<u64> max   = 0;
+    };
+
+    usz m_shard_count;
+    std::unique_ptr<shard[]> m_shards;
+};
+
+///
+/// @}
+///
+
+} // namespace qz
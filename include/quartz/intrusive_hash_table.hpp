@@ -0,0 +1,176 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+
+#include "quartz/array.hpp"
+#include "quartz/assert.hpp"
+#include "quartz/intrusive_list.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @ingroup QzContainers
+///
+/// @brief A hash table with a fixed number of buckets whose links are stored inside the elements themselves.
+/// @details Every bucket is a qz::intrusive_list, so the table never allocates, and unlinking an element given a
+/// reference to it is O(1). Keys are unique; the key of an element is obtained through the `KeyOf` function object
+/// and must not change while the element is linked into the table.
+///
+/// Hashes are mixed with the SplitMix64 finalizer before their low bits pick a bucket. Standard library hashes of
+/// integers and pointers are often the identity, so the raw low bits would crowd aligned pointers and multiples of a
+/// power of two into a fraction of the buckets.
+///
+/// @tparam T The element type. Must inherit from `qz::intrusive_list_hook<Tag>`.
+/// @tparam N The number of buckets. Must be a power of two.
+/// @tparam KeyOf A function object returning the key of an element.
+/// @tparam Hash The hash function object for the keys.
+/// @tparam KeyEqual The equality function object for the keys.
+/// @tparam Tag The tag of the hook used by this table.
+///
+template <class T, usz N, class KeyOf,
+          class Hash     = std::hash<std::remove_cvref_t<std::invoke_result_t<KeyOf, const T &>>>,
+          class KeyEqual = std::equal_to<>, class Tag = void>
+class intrusive_hash_table
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "The bucket count must be a power of two.");
+
+    using bucket_type = intrusive_list<T, Tag>;
+
+  public:
+    // TYPEDEFS
+
+    using key_type        = std::remove_cvref_t<std::invoke_result_t<KeyOf, const T &>>;
+    using value_type      = T;
+    using size_type       = usz;
+    using hasher          = Hash;
+    using key_equal       = KeyEqual;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using pointer         = value_type *;
+    using const_pointer   = const value_type *;
+
+    // METHODS
+
+    /// @brief Link an element into the table.
+    /// @param value The element being linked. Must not be linked into another list or table using the same hook.
+    /// @return True if the element was linked, false if an element with an equal key is already linked.
+    constexpr bool insert(reference value)
+    {
+        auto &bucket = bucket_for(KeyOf{}(value));
+        for (auto &element : bucket)
+        {
+            if (KeyEqual{}(KeyOf{}(element), KeyOf{}(value)))
+            {
+                return false;
+            }
+        }
+        bucket.push_front(value);
+        ++m_size;
+        return true;
+    }
+
+    /// @brief Unlink the given element from the table in O(1).
+    /// @param value The element being unlinked. Must be linked into this table.
+    constexpr void erase(reference value)
+    {
+        bucket_for(KeyOf{}(value)).erase(value);
+        --m_size;
+    }
+
+    /// @brief Unlink the element with the given key from the table.
+    /// @param key The key of the element being unlinked.
+    /// @return A pointer to the unlinked element, or nullptr if no element has the given key.
+    constexpr pointer erase(const key_type &key)
+    {
+        auto *value = find(key);
+        if (value != nullptr)
+        {
+            erase(*value);
+        }
+        return value;
+    }
+
+    /// @brief Unlink all elements from the table.
+    constexpr void clear()
+    {
+        for (auto &bucket : m_buckets)
+        {
+            bucket.clear();
+        }
+        m_size = 0;
+    }
+
+    /// @brief Find the element with the given key.
+    /// @return A pointer to the element, or nullptr if no element has the given key.
+    [[nodiscard]] constexpr pointer find(const key_type &key)
+    {
+        for (auto &element : bucket_for(key))
+        {
+            if (KeyEqual{}(KeyOf{}(element), key))
+            {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief Find the element with the given key.
+    /// @return A const pointer to the element, or nullptr if no element has the given key.
+    [[nodiscard]] constexpr const_pointer find(const key_type &key) const
+    {
+        return const_cast<intrusive_hash_table *>(this)->find(key); // NOLINT
+    }
+
+    /// @brief True if an element with the given key is linked into the table, else false.
+    [[nodiscard]] constexpr bool contains(const key_type &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /// @brief True if there are no elements linked into the table, else false.
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// @brief Get the number of elements linked into the table.
+    [[nodiscard]] constexpr size_type size() const
+    {
+        return m_size;
+    }
+
+    /// @brief Get the number of buckets in the table.
+    [[nodiscard]] static constexpr size_type bucket_count()
+    {
+        return N;
+    }
+
+    /// @brief Get the number of elements linked into the given bucket.
+    [[nodiscard]] constexpr size_type bucket_size(size_type bucket) const
+    {
+        return m_buckets[bucket].size();
+    }
+
+    /// @brief Get the index of the bucket an element with the given key is linked into.
+    [[nodiscard]] constexpr size_type bucket(const key_type &key) const
+    {
+        auto mixed = static_cast<u64>(Hash{}(key));
+        mixed      = (mixed ^ (mixed >> 30U)) * 0xBF58476D1CE4E5B9U;
+        mixed      = (mixed ^ (mixed >> 27U)) * 0x94D049BB133111EBU;
+        return static_cast<size_type>(mixed ^ (mixed >> 31U)) & (N - 1);
+    }
+
+  private:
+    [[nodiscard]] constexpr bucket_type &bucket_for(const key_type &key)
+    {
+        return m_buckets[bucket(key)];
+    }
+
+    array<bucket_type, N> m_buckets;
+    usz m_size = 0;
+};
+
+} // namespace qz
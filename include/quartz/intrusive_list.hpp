@@ -0,0 +1,464 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+
+#include "quartz/assert.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+template <class T, class Tag>
+class intrusive_list;
+
+///
+/// @ingroup QzContainers
+///
+/// @brief The hook which makes a type linkable into a qz::intrusive_list.
+/// @details Types inherit from this hook to become linkable. A type may inherit from multiple hooks with different
+/// tags to be linked into multiple lists at the same time. Copying an object never copies its links, the copy always
+/// starts out unlinked.
+///
+/// @tparam Tag A tag type used to tell apart multiple hooks inside the same type.
+///
+template <class Tag = void>
+class intrusive_list_hook
+{
+  public:
+    constexpr intrusive_list_hook() = default;
+
+    constexpr intrusive_list_hook([[maybe_unused]] const intrusive_list_hook &other) noexcept
+    {
+        // empty. copies start out unlinked.
+    }
+
+    constexpr intrusive_list_hook &operator=([[maybe_unused]] const intrusive_list_hook &other) noexcept
+    {
+        return *this;
+    }
+
+    constexpr ~intrusive_list_hook()
+    {
+        QZ_ASSERT_MSG(!is_linked(), "Intrusive list element destroyed while still linked into a list.");
+    }
+
+    /// @brief True if this hook is currently linked into a list, else false.
+    [[nodiscard]] constexpr bool is_linked() const
+    {
+        return m_next != nullptr;
+    }
+
+  private:
+    template <class T, class ListTag>
+    friend class intrusive_list;
+
+    intrusive_list_hook *m_next = nullptr;
+    intrusive_list_hook *m_prev = nullptr;
+};
+
+///
+/// @ingroup QzContainers
+///
+/// @brief A doubly linked list whose links are stored inside the elements themselves.
+/// @details The list never allocates and never owns its elements. Elements are linked in and unlinked in O(1),
+/// including unlinking an element given just a reference to it. The caller must keep elements alive while they are
+/// linked. In debug builds, linking an already linked element or destroying a linked element triggers an assertion.
+///
+/// @tparam T The element type. Must inherit from `qz::intrusive_list_hook<Tag>`.
+/// @tparam Tag The tag of the hook used by this list.
+///
+template <class T, class Tag = void>
+class intrusive_list
+{
+    using hook_type = intrusive_list_hook<Tag>;
+
+    static_assert(std::is_base_of_v<hook_type, T>, "The element type must inherit from qz::intrusive_list_hook<Tag>.");
+
+    template <class U>
+    class basic_iterator
+    {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = std::remove_const_t<U>;
+        using difference_type   = ssz;
+        using pointer           = U *;
+        using reference         = U &;
+
+        constexpr basic_iterator() = default;
+
+        constexpr explicit basic_iterator(hook_type *node) : m_node(node)
+        {
+        }
+
+        // allow conversion from iterator to const_iterator.
+        constexpr operator basic_iterator<const U>() const // NOLINT (implicit conversion)
+            requires(!std::is_const_v<U>)
+        {
+            return basic_iterator<const U>(m_node);
+        }
+
+        [[nodiscard]] constexpr reference operator*() const
+        {
+            return static_cast<reference>(*m_node);
+        }
+
+        [[nodiscard]] constexpr pointer operator->() const
+        {
+            return &**this;
+        }
+
+        constexpr basic_iterator &operator++()
+        {
+            m_node = m_node->m_next;
+            return *this;
+        }
+
+        constexpr basic_iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr basic_iterator &operator--()
+        {
+            m_node = m_node->m_prev;
+            return *this;
+        }
+
+        constexpr basic_iterator operator--(int)
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const basic_iterator &other) const = default;
+
+      private:
+        friend class intrusive_list;
+
+        hook_type *m_node = nullptr;
+    };
+
+  public:
+    // TYPEDEFS
+
+    using value_type             = T;
+    using size_type              = usz;
+    using difference_type        = ssz;
+    using reference              = value_type &;
+    using const_reference        = const value_type &;
+    using pointer                = value_type *;
+    using const_pointer          = const value_type *;
+    using iterator               = basic_iterator<T>;
+    using const_iterator         = basic_iterator<const T>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // CONSTRUCTORS & DESTRUCTOR
+
+    constexpr intrusive_list()
+    {
+        m_head.m_next = &m_head;
+        m_head.m_prev = &m_head;
+    }
+
+    intrusive_list(const intrusive_list &other)            = delete;
+    intrusive_list &operator=(const intrusive_list &other) = delete;
+
+    /// @brief Take over the elements linked into the other list. The other list is left empty.
+    constexpr intrusive_list(intrusive_list &&other) noexcept : intrusive_list()
+    {
+        splice(end(), other);
+    }
+
+    /// @brief Unlink all elements of this list and take over the elements linked into the other list.
+    constexpr intrusive_list &operator=(intrusive_list &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            splice(end(), other);
+        }
+        return *this;
+    }
+
+    /// @brief Unlink all elements of this list. The elements themselves are left untouched.
+    constexpr ~intrusive_list()
+    {
+        clear();
+        m_head.m_next = nullptr;
+        m_head.m_prev = nullptr;
+    }
+
+    // METHODS
+
+    /// @brief Link an element at the front of this list.
+    /// @param value The element being linked. Must not be linked into another list using the same hook.
+    constexpr void push_front(reference value)
+    {
+        link_before(m_head.m_next, value);
+    }
+
+    /// @brief Link an element at the back of this list.
+    /// @param value The element being linked. Must not be linked into another list using the same hook.
+    constexpr void push_back(reference value)
+    {
+        link_before(&m_head, value);
+    }
+
+    /// @brief Unlink the first element of this list. The list must not be empty.
+    constexpr void pop_front()
+    {
+        QZ_ASSERT_MSG(!empty(), "Calling pop_front() on an empty intrusive list.");
+        unlink(m_head.m_next);
+    }
+
+    /// @brief Unlink the last element of this list. The list must not be empty.
+    constexpr void pop_back()
+    {
+        QZ_ASSERT_MSG(!empty(), "Calling pop_back() on an empty intrusive list.");
+        unlink(m_head.m_prev);
+    }
+
+    /// @brief Link an element before the given position.
+    /// @param pos The position before which the element is linked.
+    /// @param value The element being linked. Must not be linked into another list using the same hook.
+    /// @return An iterator to the linked element.
+    constexpr iterator insert(const_iterator pos, reference value)
+    {
+        link_before(pos.m_node, value);
+        return iterator(as_hook(value));
+    }
+
+    /// @brief Unlink the given element from this list in O(1).
+    /// @param value The element being unlinked. Must be linked into this list.
+    constexpr void erase(reference value)
+    {
+        QZ_ASSERT_MSG(as_hook(value)->is_linked(), "Erasing an element which is not linked into an intrusive list.");
+        unlink(as_hook(value));
+    }
+
+    /// @brief Unlink the element at the given position.
+    /// @param pos The position of the element being unlinked.
+    /// @return An iterator to the element following the unlinked element.
+    constexpr iterator erase(const_iterator pos)
+    {
+        auto *next = pos.m_node->m_next;
+        unlink(pos.m_node);
+        return iterator(next);
+    }
+
+    /// @brief Move an already linked element to the front of this list without unlinking it first.
+    /// @param value The element being moved. Must be linked into this list.
+    constexpr void move_to_front(reference value)
+    {
+        auto *node = as_hook(value);
+        QZ_ASSERT_MSG(node->is_linked(), "Moving an element which is not linked into an intrusive list.");
+        detach(node);
+        attach_before(m_head.m_next, node);
+    }
+
+    /// @brief Move an already linked element to the back of this list without unlinking it first.
+    /// @param value The element being moved. Must be linked into this list.
+    constexpr void move_to_back(reference value)
+    {
+        auto *node = as_hook(value);
+        QZ_ASSERT_MSG(node->is_linked(), "Moving an element which is not linked into an intrusive list.");
+        detach(node);
+        attach_before(&m_head, node);
+    }
+
+    /// @brief Move all elements of the other list before the given position of this list in O(1).
+    /// @param pos The position before which the elements are linked.
+    /// @param other The list whose elements are moved. Left empty afterwards.
+    constexpr void splice(const_iterator pos, intrusive_list &other)
+    {
+        if (other.empty() || &other == this)
+        {
+            return;
+        }
+
+        auto *first = other.m_head.m_next;
+        auto *last  = other.m_head.m_prev;
+        auto *next  = pos.m_node;
+        auto *prev  = next->m_prev;
+
+        prev->m_next  = first;
+        first->m_prev = prev;
+        last->m_next  = next;
+        next->m_prev  = last;
+        m_size += other.m_size;
+
+        other.m_head.m_next = &other.m_head;
+        other.m_head.m_prev = &other.m_head;
+        other.m_size        = 0;
+    }
+
+    /// @brief Unlink all elements of this list.
+    constexpr void clear()
+    {
+        auto *node = m_head.m_next;
+        while (node != &m_head)
+        {
+            auto *next   = node->m_next;
+            node->m_next = nullptr;
+            node->m_prev = nullptr;
+            node         = next;
+        }
+        m_head.m_next = &m_head;
+        m_head.m_prev = &m_head;
+        m_size        = 0;
+    }
+
+    /// @brief Get an iterator to the given element. The element must be linked into this list.
+    [[nodiscard]] constexpr iterator iterator_to(reference value)
+    {
+        return iterator(as_hook(value));
+    }
+
+    /// @brief Get a const iterator to the given element. The element must be linked into this list.
+    [[nodiscard]] constexpr const_iterator iterator_to(const_reference value) const
+    {
+        return const_iterator(const_cast<hook_type *>(static_cast<const hook_type *>(&value))); // NOLINT
+    }
+
+    /// @brief Get a reference to the first element. The list must not be empty.
+    [[nodiscard]] constexpr reference front()
+    {
+        return *begin();
+    }
+
+    /// @brief Get a const reference to the first element. The list must not be empty.
+    [[nodiscard]] constexpr const_reference front() const
+    {
+        return *begin();
+    }
+
+    /// @brief Get a reference to the last element. The list must not be empty.
+    [[nodiscard]] constexpr reference back()
+    {
+        return *--end();
+    }
+
+    /// @brief Get a const reference to the last element. The list must not be empty.
+    [[nodiscard]] constexpr const_reference back() const
+    {
+        return *--end();
+    }
+
+    /// @brief True if there are no elements linked into this list, else false.
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// @brief Get the number of elements linked into this list.
+    [[nodiscard]] constexpr size_type size() const
+    {
+        return m_size;
+    }
+
+    /// @brief Get an iterator to the first element of this list.
+    [[nodiscard]] constexpr iterator begin()
+    {
+        return iterator(m_head.m_next);
+    }
+
+    /// @brief Get a const iterator to the first element of this list.
+    [[nodiscard]] constexpr const_iterator begin() const
+    {
+        return cbegin();
+    }
+
+    /// @brief Get a const iterator to the first element of this list.
+    [[nodiscard]] constexpr const_iterator cbegin() const
+    {
+        return const_iterator(m_head.m_next);
+    }
+
+    /// @brief Get an iterator past the last element of this list.
+    [[nodiscard]] constexpr iterator end()
+    {
+        return iterator(&m_head);
+    }
+
+    /// @brief Get a const iterator past the last element of this list.
+    [[nodiscard]] constexpr const_iterator end() const
+    {
+        return cend();
+    }
+
+    /// @brief Get a const iterator past the last element of this list.
+    [[nodiscard]] constexpr const_iterator cend() const
+    {
+        return const_iterator(const_cast<hook_type *>(&m_head)); // NOLINT
+    }
+
+    /// @brief Get a reverse iterator to the last element of this list.
+    [[nodiscard]] constexpr reverse_iterator rbegin()
+    {
+        return std::make_reverse_iterator(end());
+    }
+
+    /// @brief Get a reverse const iterator to the last element of this list.
+    [[nodiscard]] constexpr const_reverse_iterator rbegin() const
+    {
+        return std::make_reverse_iterator(cend());
+    }
+
+    /// @brief Get a reverse iterator past the first element of this list.
+    [[nodiscard]] constexpr reverse_iterator rend()
+    {
+        return std::make_reverse_iterator(begin());
+    }
+
+    /// @brief Get a reverse const iterator past the first element of this list.
+    [[nodiscard]] constexpr const_reverse_iterator rend() const
+    {
+        return std::make_reverse_iterator(cbegin());
+    }
+
+  private:
+    [[nodiscard]] static constexpr hook_type *as_hook(reference value)
+    {
+        return static_cast<hook_type *>(&value);
+    }
+
+    constexpr void link_before(hook_type *next, reference value)
+    {
+        auto *node = as_hook(value);
+        QZ_ASSERT_MSG(!node->is_linked(), "Element is already linked into an intrusive list.");
+        attach_before(next, node);
+    }
+
+    constexpr void attach_before(hook_type *next, hook_type *node)
+    {
+        node->m_next         = next;
+        node->m_prev         = next->m_prev;
+        next->m_prev->m_next = node;
+        next->m_prev         = node;
+        ++m_size;
+    }
+
+    constexpr void detach(hook_type *node)
+    {
+        node->m_prev->m_next = node->m_next;
+        node->m_next->m_prev = node->m_prev;
+        --m_size;
+    }
+
+    constexpr void unlink(hook_type *node)
+    {
+        detach(node);
+        node->m_next = nullptr;
+        node->m_prev = nullptr;
+    }
+
+    hook_type m_head;
+    usz m_size = 0;
+};
+
+} // namespace qz
@@ -65,6 +65,23 @@
 ///
 #define QZ_STRINGIFY_W(...) QZ_CONCAT(L, QZ_STRINGIFY(__VA_ARGS__))
 
+//
+
+///
+/// @defgroup QzBuildMacros Build configuration macros.
+/// @brief Macros describing how the library is being compiled.
+///
+
+#if !defined(QZ_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(_CPPUNWIND)
+    ///
+    /// @ingroup QzBuildMacros
+    /// @brief Defined when the library is built without exception support, either through the `QZ_NO_EXCEPTIONS` CMake
+    /// option or by compiling with exceptions disabled (e.g. `-fno-exceptions`). Failure paths which would otherwise
+    /// throw report the failure through the assertion handler and terminate instead.
+    ///
+    #define QZ_NO_EXCEPTIONS
+#endif
+
 ///
 /// @}
 ///
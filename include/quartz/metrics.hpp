@@ -0,0 +1,332 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <string_view>
+
+#include "quartz/hardware.hpp"
+#include "quartz/intrusive_list.hpp"
+#include "quartz/macros.hpp"
+#include "quartz/sync.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzMetrics Metrics
+/// @brief Counters and gauges which may be updated from hot paths on many threads at once, and a registry writing
+/// them out in the Prometheus text exposition format. Include <quartz/metrics.hpp> to use them.
+/// @{
+///
+
+class metric_registry;
+
+///
+/// @brief The kind of a qz::metric, which decides how its value is exposed.
+///
+enum class metric_type : u8
+{
+    counter, ///< A count which only goes up, e.g. the number of requests handled.
+    gauge,   ///< A value which goes up and down, e.g. the number of requests in flight.
+};
+
+///
+/// @brief The common part of qz::counter and qz::gauge: a name, a help text and a set of sharded values.
+/// @details Updates go to one of several shards, picked by qz::this_thread_index(), each on a cache line of its own.
+/// With at least as many shards as updating threads, an update is an uncontended atomic add on a cache line which no
+/// other thread writes to, instead of every core fighting over the same line. Reading sums up the shards, so reads
+/// cost one cache miss per shard, and are meant to be rare, e.g. once per scrape.
+///
+/// The name and help text are not copied, and must outlive the metric, e.g. string literals. A metric must not be
+/// destroyed while a registry is writing it out.
+///
+class metric : public intrusive_list_hook<>
+{
+  public:
+    /// @brief The number of shards used when none is given.
+    static constexpr usz default_shard_count = 8;
+
+    // CONSTRUCTORS
+
+    metric(const metric &)            = delete;
+    metric &operator=(const metric &) = delete;
+
+    /// @brief Remove the metric from the registry it was added to.
+    ~metric();
+
+    // METHODS
+
+    /// @brief Get the name under which the metric is exposed.
+    [[nodiscard]] std::string_view name() const
+    {
+        return m_name;
+    }
+
+    /// @brief Get the description exposed along with the metric.
+    [[nodiscard]] std::string_view help() const
+    {
+        return m_help;
+    }
+
+    /// @brief Get the kind of the metric.
+    [[nodiscard]] metric_type type() const
+    {
+        return m_type;
+    }
+
+    /// @brief Get the number of shards.
+    [[nodiscard]] usz shard_count() const
+    {
+        return m_shard_mask + 1;
+    }
+
+  protected:
+    metric(std::string_view name, std::string_view help, metric_type type, usz shard_count)
+        : m_name(name), m_help(help), m_type(type),
+          m_shard_mask(std::bit_ceil(shard_count == 0 ? usz{1} : shard_count) - 1),
+          m_shards(std::make_unique<cache_padded<std::atomic<u64>>[]>(m_shard_mask + 1))
+    {
+    }
+
+    void add_bits(u64 amount) noexcept
+    {
+        m_shards[this_thread_index() & m_shard_mask].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // the shards wrap around, so gauges sum up to the two's complement of negative values.
+    [[nodiscard]] u64 sum_bits() const noexcept
+    {
+        u64 sum = 0;
+        for (usz i = 0; i <= m_shard_mask; ++i)
+        {
+            sum += m_shards[i].value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    void reset_bits() noexcept
+    {
+        for (usz i = 0; i <= m_shard_mask; ++i)
+        {
+            m_shards[i].value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    friend class metric_registry;
+
+    std::string_view m_name;
+    std::string_view m_help;
+    metric_type m_type;
+    usz m_shard_mask;
+    std::unique_ptr<cache_padded<std::atomic<u64>>[]> m_shards;
+    metric_registry *m_registry = nullptr;
+};
+
+///
+/// @brief A sharded count of events, which only goes up.
+/// @details See qz::metric for how updates are spread over shards.
+///
+class counter : public metric
+{
+  public:
+    // CONSTRUCTORS
+
+    /// @brief Construct a counter starting at zero.
+    /// @param name The name under which the counter is exposed, conventionally ending in `_total`.
+    /// @param help The description exposed along with the counter.
+    /// @param shard_count The number of shards, rounded up to a power of two. Ideally one per updating thread.
+    counter(std::string_view name, std::string_view help, usz shard_count = default_shard_count)
+        : metric(name, help, metric_type::counter, shard_count)
+    {
+    }
+
+    // METHODS
+
+    /// @brief Add to the count.
+    void increment(u64 amount = 1) noexcept
+    {
+        add_bits(amount);
+    }
+
+    /// @brief Get the sum of all increments so far. Increments made concurrently may or may not be included.
+    [[nodiscard]] u64 value() const noexcept
+    {
+        return sum_bits();
+    }
+
+    /// @brief Reset the count to zero. Increments made concurrently with resetting may be partially lost.
+    void reset() noexcept
+    {
+        reset_bits();
+    }
+};
+
+///
+/// @brief A sharded value which goes up and down.
+/// @details See qz::metric for how updates are spread over shards. Additions from any number of threads are exact.
+/// set() adds the difference to the current value, so additions made concurrently with it are kept, but concurrent
+/// calls to set() may combine into a value neither of them set. Gauges which are set rather than added to are best
+/// set from a single thread.
+///
+class gauge : public metric
+{
+  public:
+    // CONSTRUCTORS
+
+    /// @brief Construct a gauge starting at zero.
+    /// @param name The name under which the gauge is exposed.
+    /// @param help The description exposed along with the gauge.
+    /// @param shard_count The number of shards, rounded up to a power of two. Ideally one per updating thread.
+    gauge(std::string_view name, std::string_view help, usz shard_count = default_shard_count)
+        : metric(name, help, metric_type::gauge, shard_count)
+    {
+    }
+
+    // METHODS
+
+    /// @brief Add to the value, which may be negative.
+    void add(s64 amount) noexcept
+    {
+        add_bits(static_cast<u64>(amount));
+    }
+
+    /// @brief Subtract from the value.
+    void sub(s64 amount) noexcept
+    {
+        add_bits(0 - static_cast<u64>(amount));
+    }
+
+    /// @brief Add one to the value.
+    void increment() noexcept
+    {
+        add(1);
+    }
+
+    /// @brief Subtract one from the value.
+    void decrement() noexcept
+    {
+        sub(1);
+    }
+
+    /// @brief Set the value, by adding the difference to the current value.
+    void set(s64 value) noexcept
+    {
+        add_bits(static_cast<u64>(value) - sum_bits());
+    }
+
+    /// @brief Get the current value, the sum of all additions so far.
+    [[nodiscard]] s64 value() const noexcept
+    {
+        return static_cast<s64>(sum_bits());
+    }
+};
+
+///
+/// @brief A set of metrics which are written out together, in the Prometheus text exposition format.
+/// @details Metrics are kept ordered by name, so the output is the same regardless of the order in which they were
+/// registered, e.g. by static initializers spread across translation units. Adding, removing and writing out metrics
+/// are thread safe. The registry does not own its metrics, and a metric removes itself from its registry when it is
+/// destroyed.
+///
+/// The output of write() for a counter `requests_total` looks like:
+/// ```
+/// # HELP requests_total Requests handled.
+/// # TYPE requests_total counter
+/// requests_total 1027
+/// ```
+///
+class metric_registry
+{
+  public:
+    // CONSTRUCTORS
+
+    metric_registry() = default;
+
+    metric_registry(const metric_registry &)            = delete;
+    metric_registry &operator=(const metric_registry &) = delete;
+
+    /// @brief Remove all metrics.
+    ~metric_registry();
+
+    /// @brief Get the registry shared by the whole process, which QZ_REGISTER_METRIC adds to.
+    [[nodiscard]] static metric_registry &global();
+
+    // METHODS
+
+    /// @brief Add a metric. Its name must be a valid Prometheus metric name, and unique within the registry.
+    /// @details An invalid or duplicate name, or a metric which is already in a registry, is reported through the
+    /// assertion handler and terminates the program, in release builds too.
+    /// @param metric The metric, which must not be in a registry already.
+    void add(metric &metric);
+
+    /// @brief Remove a metric from the registry, if it is in it.
+    void remove(metric &metric);
+
+    /// @brief Get the number of metrics in the registry.
+    [[nodiscard]] usz size() const;
+
+    /// @brief Write the current values of all metrics into the buffer [first, last).
+    /// @return A pointer one past the last written character, or nullptr if the buffer is too small, in which case the
+    /// contents of the buffer are unspecified.
+    char *write(char *first, char *last) const;
+
+    /// @brief Write the current values of all metrics to a file descriptor, e.g. a socket or a pipe.
+    /// @details The output is written in chunks from a buffer on the stack, and does not allocate. Sockets are written
+    /// with MSG_NOSIGNAL where available, so a peer closing the connection makes the write fail instead of raising
+    /// SIGPIPE. Writing to a pipe whose reader is gone still raises SIGPIPE, which the program has to ignore to get
+    /// false returned instead.
+    /// @return True if everything was written, false if writing to the descriptor failed.
+    bool write(int fd) const;
+
+    /// @brief Check whether the name is a valid Prometheus metric name, matching `[a-zA-Z_:][a-zA-Z0-9_:]*`.
+    [[nodiscard]] static bool is_valid_name(std::string_view name);
+
+  private:
+    template <class Sink>
+    void write_to(Sink &sink) const;
+
+    mutable mutex m_lock;
+    intrusive_list<metric> m_metrics;
+};
+
+///
+/// @brief Adds a metric to a registry when constructed. Used by QZ_REGISTER_METRIC for static registration.
+///
+struct metric_registration
+{
+    /// @brief Add the metric to the registry.
+    explicit metric_registration(metric &metric, metric_registry &registry = metric_registry::global())
+    {
+        registry.add(metric);
+    }
+};
+
+inline metric::~metric()
+{
+    if (m_registry != nullptr)
+    {
+        m_registry->remove(*this);
+    }
+}
+
+///
+/// @}
+///
+
+} // namespace qz
+
+///
+/// @ingroup QzMetrics
+/// @brief Add a metric with static storage duration to the global registry during static initialization.
+/// @details Placed at namespace scope after the definition of the metric, e.g.
+/// ```
+/// qz::counter g_requests("requests_total", "Requests handled.");
+/// QZ_REGISTER_METRIC(g_requests);
+/// ```
+/// Each use declares a uniquely named qz::metric_registration, so a file may register several metrics.
+///
+#define QZ_REGISTER_METRIC(metric)                                                                                     \
+    static const ::qz::metric_registration QZ_CONCAT(qz_metric_registration_, QZ_LINE)(metric)
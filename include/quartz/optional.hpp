@@ -0,0 +1,355 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include "quartz/assert.hpp"
+#include "quartz/utilities.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzVocabulary Vocabulary types
+/// @brief Types for passing around optional values and errors without exceptions. Include <quartz/optional.hpp> and
+/// <quartz/expected.hpp> to use them.
+///
+
+///
+/// @ingroup QzVocabulary
+/// @brief Tag type used for constructing empty optionals.
+///
+struct nullopt_t
+{
+    /// @cond Undocumented
+    constexpr explicit nullopt_t(int /* unused */)
+    {
+    }
+    /// @endcond
+};
+
+///
+/// @ingroup QzVocabulary
+/// @brief Constant used for constructing empty optionals.
+///
+inline constexpr nullopt_t nullopt{0};
+
+///
+/// @ingroup QzVocabulary
+///
+/// @brief A value which may or may not be present.
+/// @details Unlike `std::optional`, accessing an empty optional through value() reports the failure through the
+/// assertion handler instead of throwing, so it is usable in builds without exceptions. The optional is trivially
+/// copyable and destructible whenever T is.
+///
+/// @tparam T The type of the value. May be an lvalue reference, in which case the optional is a nullable pointer.
+///
+template <class T>
+class optional
+{
+  public:
+    using value_type = T;
+
+    // CONSTRUCTORS & DESTRUCTOR
+
+    constexpr optional() noexcept : m_empty(), m_has_value(false)
+    {
+    }
+
+    constexpr optional(nullopt_t /* unused */) noexcept : optional() // NOLINT (implicit conversion)
+    {
+    }
+
+    /// @brief Construct an optional holding the given value.
+    template <class U = T>
+        requires(std::is_constructible_v<T, U &&> && !std::is_same_v<std::remove_cvref_t<U>, optional> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, nullopt_t>)
+    constexpr optional(U &&value) // NOLINT (implicit conversion)
+        : m_value(static_cast<U &&>(value)), m_has_value(true)
+    {
+    }
+
+    constexpr optional(const optional &other)
+        requires(std::is_trivially_copy_constructible_v<T>)
+    = default;
+
+    constexpr optional(const optional &other)
+        requires(std::is_copy_constructible_v<T> && !std::is_trivially_copy_constructible_v<T>)
+        : optional()
+    {
+        if (other.m_has_value)
+        {
+            emplace(other.m_value);
+        }
+    }
+
+    constexpr optional(optional &&other) noexcept
+        requires(std::is_trivially_move_constructible_v<T>)
+    = default;
+
+    constexpr optional(optional &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        requires(std::is_move_constructible_v<T> && !std::is_trivially_move_constructible_v<T>)
+        : optional()
+    {
+        if (other.m_has_value)
+        {
+            emplace(qz::move(other.m_value));
+        }
+    }
+
+    constexpr optional &operator=(const optional &other)
+        requires(std::is_trivially_copy_assignable_v<T> && std::is_trivially_copy_constructible_v<T> &&
+                 std::is_trivially_destructible_v<T>)
+    = default;
+
+    constexpr optional &operator=(const optional &other)
+        requires(std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T> &&
+                 !(std::is_trivially_copy_assignable_v<T> && std::is_trivially_copy_constructible_v<T> &&
+                   std::is_trivially_destructible_v<T>))
+    {
+        if (this != &other)
+        {
+            assign(other);
+        }
+        return *this;
+    }
+
+    constexpr optional &operator=(optional &&other) noexcept
+        requires(std::is_trivially_move_assignable_v<T> && std::is_trivially_move_constructible_v<T> &&
+                 std::is_trivially_destructible_v<T>)
+    = default;
+
+    constexpr optional &operator=(optional &&other) noexcept(std::is_nothrow_move_constructible_v<T> &&
+                                                             std::is_nothrow_move_assignable_v<T>)
+        requires(std::is_move_constructible_v<T> && std::is_move_assignable_v<T> &&
+                 !(std::is_trivially_move_assignable_v<T> && std::is_trivially_move_constructible_v<T> &&
+                   std::is_trivially_destructible_v<T>))
+    {
+        if (this != &other)
+        {
+            assign(qz::move(other));
+        }
+        return *this;
+    }
+
+    constexpr ~optional()
+        requires(std::is_trivially_destructible_v<T>)
+    = default;
+
+    constexpr ~optional()
+    {
+        reset();
+    }
+
+    // METHODS
+
+    /// @brief Destroy the current value, if any, and construct a new value in place.
+    template <class... Args>
+    constexpr T &emplace(Args &&...args)
+    {
+        reset();
+        std::construct_at(&m_value, static_cast<Args &&>(args)...);
+        m_has_value = true;
+        return m_value;
+    }
+
+    /// @brief Destroy the current value, if any.
+    constexpr void reset()
+    {
+        if (m_has_value)
+        {
+            m_value.~T();
+            m_has_value = false;
+        }
+    }
+
+    /// @brief True if a value is present, else false.
+    [[nodiscard]] constexpr bool has_value() const
+    {
+        return m_has_value;
+    }
+
+    /// @brief Get a reference to the value. Reports an assertion failure if no value is present.
+    [[nodiscard]] constexpr T &value()
+    {
+        QZ_VERIFY_MSG(m_has_value, "Accessing the value of an empty optional.");
+        return m_value;
+    }
+
+    /// @brief Get a const reference to the value. Reports an assertion failure if no value is present.
+    [[nodiscard]] constexpr const T &value() const
+    {
+        QZ_VERIFY_MSG(m_has_value, "Accessing the value of an empty optional.");
+        return m_value;
+    }
+
+    /// @brief Get a copy of the value if present, else the given fallback value.
+    template <class U>
+    [[nodiscard]] constexpr T value_or(U &&fallback) const
+    {
+        return m_has_value ? m_value : static_cast<T>(static_cast<U &&>(fallback));
+    }
+
+    // OPERATOR OVERLOADS
+
+    /// @brief True if a value is present, else false.
+    [[nodiscard]] constexpr explicit operator bool() const
+    {
+        return m_has_value;
+    }
+
+    /// @brief Get a reference to the value. Only checked in debug builds.
+    [[nodiscard]] constexpr T &operator*()
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an empty optional.");
+        return m_value;
+    }
+
+    /// @brief Get a const reference to the value. Only checked in debug builds.
+    [[nodiscard]] constexpr const T &operator*() const
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an empty optional.");
+        return m_value;
+    }
+
+    /// @brief Access members of the value. Only checked in debug builds.
+    [[nodiscard]] constexpr T *operator->()
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an empty optional.");
+        return &m_value;
+    }
+
+    /// @brief Access members of the value. Only checked in debug builds.
+    [[nodiscard]] constexpr const T *operator->() const
+    {
+        QZ_ASSERT_MSG(m_has_value, "Dereferencing an empty optional.");
+        return &m_value;
+    }
+
+  private:
+    template <class Other>
+    constexpr void assign(Other &&other)
+    {
+        if (!other.m_has_value)
+        {
+            reset();
+        }
+        else if (m_has_value)
+        {
+            m_value = static_cast<Other &&>(other).m_value;
+        }
+        else
+        {
+            emplace(static_cast<Other &&>(other).m_value);
+        }
+    }
+
+    struct empty_type
+    {
+    };
+
+    union {
+        empty_type m_empty;
+        T m_value;
+    };
+    bool m_has_value;
+};
+
+///
+/// @ingroup QzVocabulary
+///
+/// @brief An optional reference, with the size and layout of a pointer.
+/// @details Assigning to the optional rebinds the reference, it never assigns through to the referenced object.
+///
+/// @tparam T The type of the referenced object.
+///
+template <class T>
+class optional<T &>
+{
+  public:
+    using value_type = T &;
+
+    constexpr optional() noexcept = default;
+
+    constexpr optional(nullopt_t /* unused */) noexcept // NOLINT (implicit conversion)
+    {
+    }
+
+    /// @brief Construct an optional referring to the given object.
+    template <class U>
+        requires(std::is_convertible_v<U *, T *>)
+    constexpr optional(U &value) noexcept : m_pointer(std::addressof(value)) // NOLINT (implicit conversion)
+    {
+    }
+
+    /// @brief Construct an optional referring to the same object as the other optional.
+    template <class U>
+        requires(std::is_convertible_v<U *, T *> && !std::is_same_v<U, T>)
+    constexpr optional(const optional<U &> &other) noexcept // NOLINT (implicit conversion)
+        : m_pointer(other.has_value() ? std::addressof(*other) : nullptr)
+    {
+    }
+
+    // binding to temporaries would leave the reference dangling.
+    template <class U>
+        requires(!std::is_lvalue_reference_v<U> && std::is_convertible_v<std::remove_cvref_t<U> *, T *>)
+    optional(U &&value) = delete;
+
+    /// @brief Make this optional refer to the given object.
+    constexpr T &emplace(T &value) noexcept
+    {
+        m_pointer = std::addressof(value);
+        return value;
+    }
+
+    /// @brief Make this optional refer to nothing.
+    constexpr void reset() noexcept
+    {
+        m_pointer = nullptr;
+    }
+
+    /// @brief True if the optional refers to an object, else false.
+    [[nodiscard]] constexpr bool has_value() const
+    {
+        return m_pointer != nullptr;
+    }
+
+    /// @brief Get the referenced object. Reports an assertion failure if the optional is empty.
+    [[nodiscard]] constexpr T &value() const
+    {
+        QZ_VERIFY_MSG(m_pointer != nullptr, "Accessing the value of an empty optional.");
+        return *m_pointer;
+    }
+
+    /// @brief Get a copy of the referenced object if present, else the given fallback value.
+    template <class U>
+    [[nodiscard]] constexpr std::remove_cv_t<T> value_or(U &&fallback) const
+    {
+        return m_pointer != nullptr ? *m_pointer : static_cast<std::remove_cv_t<T>>(static_cast<U &&>(fallback));
+    }
+
+    /// @brief True if the optional refers to an object, else false.
+    [[nodiscard]] constexpr explicit operator bool() const
+    {
+        return m_pointer != nullptr;
+    }
+
+    /// @brief Get the referenced object. Only checked in debug builds.
+    [[nodiscard]] constexpr T &operator*() const
+    {
+        QZ_ASSERT_MSG(m_pointer != nullptr, "Dereferencing an empty optional.");
+        return *m_pointer;
+    }
+
+    /// @brief Access members of the referenced object. Only checked in debug builds.
+    [[nodiscard]] constexpr T *operator->() const
+    {
+        QZ_ASSERT_MSG(m_pointer != nullptr, "Dereferencing an empty optional.");
+        return m_pointer;
+    }
+
+  private:
+    T *m_pointer = nullptr;
+};
+
+} // namespace qz
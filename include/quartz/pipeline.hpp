@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "quartz/assert.hpp"
+#include "quartz/coroutine.hpp"
+#include "quartz/types.hpp"
+#include "quartz/utilities.hpp"
+
+namespace qz
+{
+
+/// @cond Undocumented
+namespace detail
+{
+
+template <class T>
+struct pipeline_element
+{
+    using type = T;
+};
+
+// generators yielding spans pass on all the items of each span at once.
+template <class T>
+struct pipeline_element<std::span<const T>>
+{
+    using type = T;
+};
+
+template <class T>
+using pipeline_element_t = typename pipeline_element<T>::type;
+
+template <class Stage, class In>
+auto invoke_stage(Stage &stage, frame_arena &arena, std::span<const In> batch)
+{
+    if constexpr (std::is_invocable_v<Stage &, frame_arena &, std::span<const In>>)
+    {
+        return std::invoke(stage, arena, batch);
+    }
+    else
+    {
+        return std::invoke(stage, batch);
+    }
+}
+
+template <class Stage, class In>
+using stage_output_t = pipeline_element_t<typename decltype(invoke_stage(
+    std::declval<Stage &>(), std::declval<frame_arena &>(), std::declval<std::span<const In>>()))::value_type>;
+
+// the batches feeding each stage and the sink, given the items flowing into the first stage.
+template <class In, class... Stages>
+struct pipeline_types
+{
+    using batches = std::tuple<std::vector<In>>;
+    using output  = In;
+};
+
+template <class In, class Stage, class... Rest>
+struct pipeline_types<In, Stage, Rest...>
+{
+    using next    = pipeline_types<stage_output_t<Stage, In>, Rest...>;
+    using batches = decltype(std::tuple_cat(std::declval<std::tuple<std::vector<In>>>(),
+                                            std::declval<typename next::batches>()));
+    using output  = typename next::output;
+};
+
+} // namespace detail
+/// @endcond
+
+///
+/// @ingroup QzCoroutines
+///
+/// @brief A chain of generator stages run on the calling thread, passing items between stages in batches.
+/// @details The items of the source generator are collected into a batch, and each full batch is handed to the first
+/// stage. A stage is a callable taking a `std::span<const In>` of items, optionally preceded by a `qz::frame_arena &`,
+/// and returning a generator of the items it produces from that batch. Its outputs are collected into the batch of the
+/// next stage, which is handed on once full, and so on until the sink receives the batches of the last stage.
+///
+/// A stage is started once per batch, and the stage after it loops over whole batches without suspending. Resuming a
+/// coroutine costs an indirect call and a dispatch on its suspension point, so stages which yield one item at a time
+/// pay that per item. Stages and sources may instead yield a `std::span<const Out>` of many items at once, e.g. the
+/// results for the whole input batch, which costs a single resume per span. Full batches within a span are handed on
+/// without being copied. Stage frames are taken from an arena on the stack of run(), since at most one frame per stage
+/// is alive at a time.
+///
+/// @tparam T The type yielded by the source, either items or spans of items.
+/// @tparam Stages The types of the stages, in order.
+///
+template <class T, class... Stages>
+class pipeline
+{
+    using item_type = detail::pipeline_element_t<T>;
+    using types     = detail::pipeline_types<item_type, Stages...>;
+    using batches   = typename types::batches;
+
+  public:
+    // TYPEDEFS
+
+    /// @brief The type of the items produced by the last stage.
+    using output_type = typename types::output;
+
+    /// @brief The size of the arena in run(). Frames which do not fit are allocated on the heap.
+    static constexpr usz arena_size = 4096;
+
+    // CONSTRUCTORS
+
+    /// @brief Construct a pipeline without stages over the given source.
+    /// @param source The generator producing the items.
+    /// @param batch_size The number of items passed to each stage at once.
+    pipeline(generator<T> source, usz batch_size)
+        requires(sizeof...(Stages) == 0)
+        : m_source(qz::move(source)), m_batch_size(batch_size)
+    {
+        QZ_ASSERT_MSG(batch_size > 0, "Pipeline batches must hold at least one item.");
+    }
+
+    // METHODS
+
+    /// @brief Append a stage to the end of the pipeline.
+    /// @return The pipeline with the stage appended, which replaces this one.
+    template <class Stage>
+    [[nodiscard]] pipeline<T, Stages..., Stage> then(Stage stage) &&
+    {
+        return pipeline<T, Stages..., Stage>(qz::move(m_source), m_batch_size,
+                                             std::tuple_cat(qz::move(m_stages), std::tuple<Stage>(qz::move(stage))));
+    }
+
+    /// @brief Run the pipeline until the source is exhausted, and every item has passed through all stages.
+    /// @details Running consumes the pipeline, since its source generator is finished afterwards and cannot be resumed
+    /// again.
+    /// @param sink The callable receiving the batches of the last stage, as a `std::span<const output_type>`. Only the
+    /// last batch may be smaller than the batch size.
+    template <class Sink>
+    void run(Sink &&sink) &&
+    {
+        alignas(frame_arena::alignment) std::byte arena_buffer[arena_size];
+        frame_arena arena(arena_buffer);
+
+        batches batches;
+        std::apply([&](auto &...batch) { (batch.reserve(m_batch_size), ...); }, batches);
+
+        for (const auto &value : m_source)
+        {
+            append<0>(value, batches, arena, sink);
+        }
+
+        // partial batches are flushed in stage order, as each flush may add to the batches of later stages.
+        flush<0>(batches, arena, sink);
+    }
+
+  private:
+    template <class, class...>
+    friend class pipeline;
+
+    pipeline(generator<T> source, usz batch_size, std::tuple<Stages...> stages)
+        : m_source(qz::move(source)), m_stages(qz::move(stages)), m_batch_size(batch_size)
+    {
+    }
+
+    // adds an item, or all the items of a span, to the batch of the given stage, handing it on whenever it fills up.
+    // Full batches within a span are handed on in place.
+    template <usz I, class Value, class Sink>
+    void append(const Value &value, batches &batches, frame_arena &arena, Sink &sink)
+    {
+        auto &batch = std::get<I>(batches);
+        if constexpr (std::is_same_v<Value, std::span<const typename std::decay_t<decltype(batch)>::value_type>>)
+        {
+            for (auto remaining = value; !remaining.empty();)
+            {
+                if (batch.empty() && remaining.size() >= m_batch_size)
+                {
+                    process<I>(remaining.first(m_batch_size), batches, arena, sink);
+                    remaining = remaining.subspan(m_batch_size);
+                    continue;
+                }
+                const auto count = std::min(remaining.size(), m_batch_size - batch.size());
+                batch.insert(batch.end(), remaining.begin(), remaining.begin() + static_cast<ssz>(count));
+                remaining = remaining.subspan(count);
+                if (batch.size() == m_batch_size)
+                {
+                    hand_on<I>(batches, arena, sink);
+                }
+            }
+        }
+        else
+        {
+            batch.push_back(value);
+            if (batch.size() == m_batch_size)
+            {
+                hand_on<I>(batches, arena, sink);
+            }
+        }
+    }
+
+    template <usz I, class Sink>
+    void hand_on(batches &batches, frame_arena &arena, Sink &sink)
+    {
+        auto &batch = std::get<I>(batches);
+        process<I>(std::span(std::as_const(batch)), batches, arena, sink);
+        batch.clear();
+    }
+
+    template <usz I, class In, class Sink>
+    void process(std::span<const In> items, batches &batches, frame_arena &arena, Sink &sink)
+    {
+        if constexpr (I == sizeof...(Stages))
+        {
+            sink(items);
+        }
+        else
+        {
+            for (const auto &value : detail::invoke_stage(std::get<I>(m_stages), arena, items))
+            {
+                append<I + 1>(value, batches, arena, sink);
+            }
+        }
+    }
+
+    template <usz I, class Sink>
+    void flush(batches &batches, frame_arena &arena, Sink &sink)
+    {
+        if (!std::get<I>(batches).empty())
+        {
+            hand_on<I>(batches, arena, sink);
+        }
+        if constexpr (I < sizeof...(Stages))
+        {
+            flush<I + 1>(batches, arena, sink);
+        }
+    }
+
+    generator<T> m_source;
+    std::tuple<Stages...> m_stages;
+    usz m_batch_size;
+};
+
+template <class T>
+pipeline(generator<T>, usz) -> pipeline<T>;
+
+} // namespace qz
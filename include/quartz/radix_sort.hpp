@@ -0,0 +1,597 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "quartz/array.hpp"
+#include "quartz/assert.hpp"
+#include "quartz/hardware.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzSort Sorting
+/// @brief Sorting algorithms specialised for fixed-width keys. Include <quartz/radix_sort.hpp> to use them.
+/// @{
+///
+
+///
+/// @brief Concept for the key types accepted by qz::radix_sort. Integers other than `bool`, and floating point types.
+///
+template <class T>
+concept radix_sortable = (std::integral<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, f32> ||
+                         std::is_same_v<T, f64>;
+
+/// @cond Undocumented
+namespace detail
+{
+
+inline constexpr usz radix_size = 256;
+
+// ranges below this size are insertion sorted, and threads are only used for at least this many keys each.
+inline constexpr usz radix_insertion_size  = 64;
+inline constexpr usz radix_keys_per_thread = usz{1} << 16;
+
+// ranges of up to this many bytes of keys and values are sorted digit by digit within the caches. Larger ranges are
+// first split by their most significant digit.
+inline constexpr usz radix_cache_size = usz{1} << 19;
+
+template <class T>
+using radix_bits_t = std::conditional_t<
+    sizeof(T) == 1, u8, std::conditional_t<sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+
+// maps a key to an unsigned integer which orders the same way. The sign bit of signed integers is flipped, and for
+// floats all bits of negative values are flipped as well, so that larger magnitudes come first.
+template <class T>
+constexpr radix_bits_t<T> radix_key(T key)
+{
+    using bits          = radix_bits_t<T>;
+    constexpr auto sign = static_cast<bits>(bits{1} << (sizeof(T) * 8 - 1));
+    if constexpr (std::floating_point<T>)
+    {
+        const auto value = std::bit_cast<bits>(key);
+        return value ^ (static_cast<bits>(bits{0} - (value >> (sizeof(T) * 8 - 1))) | sign);
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+        return static_cast<bits>(static_cast<bits>(key) ^ sign);
+    }
+    else
+    {
+        return key;
+    }
+}
+
+template <class T>
+constexpr usz radix_digit(T key, usz digit)
+{
+    return static_cast<usz>(radix_key(key) >> (digit * 8)) & (radix_size - 1);
+}
+
+using radix_counts = array<usz, radix_size>;
+
+template <class Key>
+using radix_histograms = array<radix_counts, sizeof(Key)>;
+
+// keys, and the values moved along with them unless the value type is void.
+template <class Key, class Value>
+struct radix_span
+{
+    static constexpr usz item_size =
+        sizeof(Key) + (std::is_void_v<Value> ? 0 : sizeof(std::conditional_t<std::is_void_v<Value>, char, Value>));
+
+    [[nodiscard]] radix_span subspan(usz offset) const
+    {
+        if constexpr (std::is_void_v<Value>)
+        {
+            return {keys + offset, nullptr};
+        }
+        else
+        {
+            return {keys + offset, values + offset};
+        }
+    }
+
+    Key *keys;
+    Value *values;
+};
+
+template <class Key, class Value>
+void radix_copy(radix_span<Key, Value> from, radix_span<Key, Value> to, usz begin, usz end)
+{
+    std::memcpy(to.keys + begin, from.keys + begin, (end - begin) * sizeof(Key));
+    if constexpr (!std::is_void_v<Value>)
+    {
+        std::memcpy(to.values + begin, from.values + begin, (end - begin) * sizeof(Value));
+    }
+}
+
+// stable, for ranges too small to be worth counting.
+template <class Key, class Value>
+void radix_insertion_sort(radix_span<Key, Value> data, usz size)
+{
+    for (usz i = 1; i < size; ++i)
+    {
+        const Key key   = data.keys[i];
+        const auto bits = radix_key(key);
+        usz j           = i;
+        if constexpr (std::is_void_v<Value>)
+        {
+            for (; j > 0 && radix_key(data.keys[j - 1]) > bits; --j)
+            {
+                data.keys[j] = data.keys[j - 1];
+            }
+        }
+        else
+        {
+            const Value value = data.values[i];
+            for (; j > 0 && radix_key(data.keys[j - 1]) > bits; --j)
+            {
+                data.keys[j]   = data.keys[j - 1];
+                data.values[j] = data.values[j - 1];
+            }
+            data.values[j] = value;
+        }
+        data.keys[j] = key;
+    }
+}
+
+// counts every digit of the keys in [begin, end) at once.
+template <class Key>
+void radix_count(const Key *keys, usz begin, usz end, radix_histograms<Key> &histograms)
+{
+    for (auto &counts : histograms)
+    {
+        counts.fill(0);
+    }
+    for (usz i = begin; i < end; ++i)
+    {
+        const auto bits = radix_key(keys[i]);
+        for (usz digit = 0; digit < sizeof(Key); ++digit)
+        {
+            ++histograms[digit][static_cast<usz>(bits >> (digit * 8)) & (radix_size - 1)];
+        }
+    }
+}
+
+// finds the digits below the limit which differ between the keys, lowest first, as a pass over the others would not
+// move anything. The histograms of several chunks of the keys are summed up.
+template <class Key>
+usz radix_plan(std::span<const radix_histograms<Key>> histograms, Key first, usz size, usz limit,
+               array<usz, sizeof(Key)> &passes)
+{
+    usz pass_count = 0;
+    for (usz digit = 0; digit < limit; ++digit)
+    {
+        const usz bucket = radix_digit(first, digit);
+        usz total        = 0;
+        for (const auto &chunk : histograms)
+        {
+            total += chunk[digit][bucket];
+        }
+        if (total != size)
+        {
+            passes[pass_count++] = digit;
+        }
+    }
+    return pass_count;
+}
+
+// collects the items scattered to each bucket in a cache line sized buffer, and writes them out a line at a time, so
+// that the 256 scattered write streams turn into whole line writes. On x86, lines which fill a whole cache line of the
+// destination are written with non-temporal stores, which do not read the destination into the caches first. The
+// partial lines at the ends of a bucket are copied as usual.
+template <class T>
+class radix_lines
+{
+  public:
+    static constexpr usz line_size = std::max<usz>(1, cache_line_size / sizeof(T));
+
+#if defined(_M_X64) || defined(__x86_64__)
+    static constexpr bool streamed = line_size * sizeof(T) == cache_line_size && alignof(T) == sizeof(T);
+#else
+    static constexpr bool streamed = false;
+#endif
+
+    radix_lines(T *to, const radix_counts &offsets) : m_to(to)
+    {
+        for (usz bucket = 0; bucket < radix_size; ++bucket)
+        {
+            // streamed lines are aligned to the destination, so the first line of a bucket may start part way in.
+            usz slot = 0;
+            if constexpr (streamed)
+            {
+                slot = reinterpret_cast<std::uintptr_t>(to + offsets[bucket]) % cache_line_size / sizeof(T);
+            }
+            m_fill[bucket]    = static_cast<u8>(slot);
+            m_first[bucket]   = static_cast<u8>(slot);
+            m_offsets[bucket] = offsets[bucket] - slot;
+        }
+    }
+
+    void push(usz bucket, const T &item)
+    {
+        const usz slot        = m_fill[bucket]++;
+        m_lines[bucket][slot] = item;
+        if (slot + 1 == line_size)
+        {
+            write(bucket, line_size);
+            m_offsets[bucket] += line_size;
+            m_fill[bucket]  = 0;
+            m_first[bucket] = 0;
+        }
+    }
+
+    void flush()
+    {
+        for (usz bucket = 0; bucket < radix_size; ++bucket)
+        {
+            write(bucket, m_fill[bucket]);
+        }
+#if defined(_M_X64) || defined(__x86_64__)
+        if constexpr (streamed)
+        {
+            _mm_sfence();
+        }
+#endif
+    }
+
+  private:
+    void write(usz bucket, usz end)
+    {
+        const usz first = m_first[bucket];
+#if defined(_M_X64) || defined(__x86_64__)
+        if constexpr (streamed)
+        {
+            if (first == 0 && end == line_size)
+            {
+                const auto *source = reinterpret_cast<const __m128i *>(m_lines[bucket]);
+                auto *target       = reinterpret_cast<__m128i *>(m_to + m_offsets[bucket]);
+                for (usz i = 0; i < cache_line_size / sizeof(__m128i); ++i)
+                {
+                    _mm_stream_si128(target + i, _mm_load_si128(source + i));
+                }
+                return;
+            }
+        }
+#endif
+        // the offset of a bucket wraps around below zero while its first slot is not yet written.
+        std::memcpy(m_to + (m_offsets[bucket] + first), &m_lines[bucket][first], (end - first) * sizeof(T));
+    }
+
+    alignas(cache_line_size) T m_lines[radix_size][line_size];
+    T *m_to;
+    radix_counts m_offsets;
+    array<u8, radix_size> m_fill;
+    array<u8, radix_size> m_first;
+};
+
+// moves the items in [begin, end) to the offsets of the buckets of their digit. Items are stored directly when the
+// destination fits in the caches, and collected into whole lines otherwise.
+template <class Key, class Value>
+void radix_scatter(radix_span<Key, Value> from, radix_span<Key, Value> to, usz begin, usz end, usz digit,
+                   radix_counts offsets, bool in_cache)
+{
+    if (in_cache)
+    {
+        for (usz i = begin; i < end; ++i)
+        {
+            const usz target = offsets[radix_digit(from.keys[i], digit)]++;
+            to.keys[target]  = from.keys[i];
+            if constexpr (!std::is_void_v<Value>)
+            {
+                to.values[target] = from.values[i];
+            }
+        }
+    }
+    else if constexpr (std::is_void_v<Value>)
+    {
+        radix_lines<Key> keys(to.keys, offsets);
+        for (usz i = begin; i < end; ++i)
+        {
+            keys.push(radix_digit(from.keys[i], digit), from.keys[i]);
+        }
+        keys.flush();
+    }
+    else
+    {
+        radix_lines<Key> keys(to.keys, offsets);
+        radix_lines<Value> values(to.values, offsets);
+        for (usz i = begin; i < end; ++i)
+        {
+            const usz bucket = radix_digit(from.keys[i], digit);
+            keys.push(bucket, from.keys[i]);
+            values.push(bucket, from.values[i]);
+        }
+        keys.flush();
+        values.flush();
+    }
+}
+
+inline radix_counts radix_offsets(const radix_counts &counts)
+{
+    radix_counts offsets;
+    usz offset = 0;
+    for (usz bucket = 0; bucket < radix_size; ++bucket)
+    {
+        offsets[bucket] = offset;
+        offset += counts[bucket];
+    }
+    return offsets;
+}
+
+// sorts the first size items of `from` by their digits below the limit, using `to` as scratch space. The result ends
+// up in `to` if into_to is set, else in `from`.
+template <class Key, class Value>
+void radix_sort_range(radix_span<Key, Value> from, radix_span<Key, Value> to, usz size, usz limit, bool into_to)
+{
+    if (size < radix_insertion_size)
+    {
+        radix_insertion_sort(from, size);
+        if (into_to)
+        {
+            radix_copy(from, to, 0, size);
+        }
+        return;
+    }
+
+    radix_histograms<Key> histograms;
+    radix_count(from.keys, 0, size, histograms);
+    array<usz, sizeof(Key)> passes;
+    const usz pass_count = radix_plan<Key>({&histograms, 1}, from.keys[0], size, limit, passes);
+
+    const bool in_cache = size * radix_span<Key, Value>::item_size <= radix_cache_size;
+    if (pass_count > 1 && !in_cache)
+    {
+        // split by the most significant digit, and sort each bucket by the digits below it within the caches.
+        const usz digit  = passes[pass_count - 1];
+        const auto start = radix_offsets(histograms[digit]);
+        radix_scatter(from, to, 0, size, digit, start, false);
+        for (usz bucket = 0; bucket < radix_size; ++bucket)
+        {
+            const usz count = histograms[digit][bucket];
+            if (count > 0)
+            {
+                radix_sort_range(to.subspan(start[bucket]), from.subspan(start[bucket]), count, digit, !into_to);
+            }
+        }
+        return;
+    }
+
+    for (usz pass = 0; pass < pass_count; ++pass)
+    {
+        radix_scatter(from, to, 0, size, passes[pass], radix_offsets(histograms[passes[pass]]), in_cache);
+        std::swap(from, to);
+    }
+    // the items are in `from` after an even number of passes.
+    if ((pass_count % 2 == 1) != into_to)
+    {
+        radix_copy(from, to, 0, size);
+    }
+}
+
+// sorts with several threads. Each thread counts and scatters a chunk of the items by the most significant digit,
+// writing each bucket after the items of that bucket from the threads before it. The buckets are then sorted by the
+// threads independently.
+template <class Key, class Value>
+class radix_sorter
+{
+    using span = radix_span<Key, Value>;
+
+  public:
+    radix_sorter(span data, span scratch, usz size, usz thread_count)
+        : m_data(data), m_scratch(scratch), m_size(size), m_thread_count(thread_count), m_histograms(thread_count),
+          m_offsets(thread_count), m_sync(static_cast<std::ptrdiff_t>(thread_count))
+    {
+    }
+
+    void run()
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(m_thread_count - 1);
+        for (usz thread = 1; thread < m_thread_count; ++thread)
+        {
+            threads.emplace_back([this, thread] { work(thread); });
+        }
+        work(0);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+  private:
+    [[nodiscard]] usz chunk_begin(usz thread) const
+    {
+        return m_size * thread / m_thread_count;
+    }
+
+    void work(usz thread)
+    {
+        radix_count(m_data.keys, chunk_begin(thread), chunk_begin(thread + 1), m_histograms[thread]);
+        m_sync.arrive_and_wait();
+
+        // the first thread plans the passes while the others wait.
+        if (thread == 0)
+        {
+            plan();
+        }
+        m_sync.arrive_and_wait();
+        if (m_pass_count == 0)
+        {
+            return;
+        }
+
+        radix_scatter(m_data, m_scratch, chunk_begin(thread), chunk_begin(thread + 1), m_digit, m_offsets[thread],
+                      m_size * span::item_size <= radix_cache_size);
+        m_sync.arrive_and_wait();
+
+        if (m_pass_count == 1)
+        {
+            radix_copy(m_scratch, m_data, chunk_begin(thread), chunk_begin(thread + 1));
+            return;
+        }
+
+        // the buckets are handed out one at a time, so that threads with smaller buckets take on more of them.
+        for (usz bucket = m_next_bucket.fetch_add(1, std::memory_order_relaxed); bucket < radix_size;
+             bucket     = m_next_bucket.fetch_add(1, std::memory_order_relaxed))
+        {
+            const usz begin = m_bucket_begin[bucket];
+            const usz count = m_bucket_begin[bucket + 1] - begin;
+            if (count > 0)
+            {
+                radix_sort_range(m_scratch.subspan(begin), m_data.subspan(begin), count, m_digit, true);
+            }
+        }
+    }
+
+    void plan()
+    {
+        array<usz, sizeof(Key)> passes;
+        m_pass_count = radix_plan<Key>(m_histograms, m_data.keys[0], m_size, sizeof(Key), passes);
+        if (m_pass_count == 0)
+        {
+            return;
+        }
+
+        // a single pass is done by the threads together, else the most significant digit splits up the work.
+        m_digit    = m_pass_count == 1 ? passes[0] : passes[m_pass_count - 1];
+        usz offset = 0;
+        for (usz bucket = 0; bucket < radix_size; ++bucket)
+        {
+            m_bucket_begin[bucket] = offset;
+            for (usz thread = 0; thread < m_thread_count; ++thread)
+            {
+                m_offsets[thread][bucket] = offset;
+                offset += m_histograms[thread][m_digit][bucket];
+            }
+        }
+        m_bucket_begin[radix_size] = offset;
+    }
+
+    span m_data;
+    span m_scratch;
+    usz m_size;
+    usz m_thread_count;
+
+    std::vector<radix_histograms<Key>> m_histograms;
+    std::vector<radix_counts> m_offsets;
+    array<usz, radix_size + 1> m_bucket_begin{};
+    usz m_pass_count = 0;
+    usz m_digit      = 0;
+
+    std::barrier<> m_sync;
+    std::atomic<usz> m_next_bucket = 0;
+};
+
+template <class Key, class Value>
+void radix_sort(Key *keys, Value *values, usz size, usz thread_count)
+{
+    using span = radix_span<Key, Value>;
+    if (size < radix_insertion_size)
+    {
+        radix_insertion_sort(span{keys, values}, size);
+        return;
+    }
+
+    auto key_scratch = std::make_unique_for_overwrite<Key[]>(size);
+    span scratch{key_scratch.get(), nullptr};
+    std::unique_ptr<std::conditional_t<std::is_void_v<Value>, u8, Value>[]> value_scratch;
+    if constexpr (!std::is_void_v<Value>)
+    {
+        value_scratch  = std::make_unique_for_overwrite<Value[]>(size);
+        scratch.values = value_scratch.get();
+    }
+
+    thread_count = std::clamp<usz>(size / radix_keys_per_thread, 1, std::max<usz>(thread_count, 1));
+    if (thread_count == 1)
+    {
+        radix_sort_range(span{keys, values}, scratch, size, sizeof(Key), false);
+        return;
+    }
+    radix_sorter<Key, Value>(span{keys, values}, scratch, size, thread_count).run();
+}
+
+} // namespace detail
+/// @endcond
+
+///
+/// @brief Sort keys in ascending order with a radix sort.
+/// @details Keys are sorted one byte at a time, so the cost is linear in the number of keys rather than `n log n`.
+/// - A first pass counts every byte of every key into a set of histograms at once. Bytes which are the same for every
+/// key, such as the high bytes of small integers, are skipped entirely.
+/// - Inputs larger than the caches are first split into 256 buckets by their most significant byte. The keys are
+/// collected in a cache line sized buffer per bucket and written out a line at a time, with non-temporal stores on
+/// x86, which keeps the number of open write streams within what the caches and the TLB handle well.
+/// - Each bucket, and every input which fits in the caches, is then sorted least significant byte first, moving the
+/// keys back and forth between the input and a scratch buffer without leaving the caches.
+/// - With several threads, each thread counts and splits its own chunk of the keys using its own histograms, and
+/// writes each bucket after those of the threads before it. The threads then sort the buckets independently.
+///
+/// Signed integers and floats are ordered through a bit transformation of their keys. Floats sort by their bit
+/// patterns: `-0.0` comes before `0.0`, and NaNs with the sign bit set come first, the others last. The sort allocates
+/// a scratch buffer the size of the keys.
+///
+/// @param keys The keys to sort.
+/// @param thread_count The maximum number of threads to use, including the calling thread. Fewer are used for small
+/// inputs.
+///
+template <radix_sortable T>
+void radix_sort(std::span<T> keys, usz thread_count = 1)
+{
+    detail::radix_sort<T, void>(keys.data(), nullptr, keys.size(), thread_count);
+}
+
+///
+/// @brief Sort keys in ascending order, moving the value at the same position along with each key.
+/// @details The sort is stable. See qz::radix_sort(std::span<T>, usz) for details.
+/// @param keys The keys to sort.
+/// @param values The values to permute along with the keys. Must be as many as there are keys.
+/// @param thread_count The maximum number of threads to use, including the calling thread.
+///
+template <radix_sortable Key, class Value>
+    requires std::is_trivially_copyable_v<Value>
+void radix_sort(std::span<Key> keys, std::span<Value> values, usz thread_count = 1)
+{
+    QZ_ASSERT_MSG(keys.size() == values.size(), "There must be a value for every key.");
+    detail::radix_sort<Key, Value>(keys.data(), values.data(), keys.size(), thread_count);
+}
+
+///
+/// @brief Compute the permutation which sorts the keys, without moving them.
+/// @details On return `keys[indices[0]], keys[indices[1]], ...` are in ascending order, and equal keys keep the order
+/// of their positions. Sorts a copy of the keys together with the indices.
+/// @param keys The keys to sort by.
+/// @param indices Receives the indices of the keys in sorted order. Must be as many as there are keys.
+/// @param thread_count The maximum number of threads to use, including the calling thread.
+///
+template <radix_sortable Key, std::unsigned_integral Index>
+void radix_sort_indices(std::span<const Key> keys, std::span<Index> indices, usz thread_count = 1)
+{
+    QZ_ASSERT_MSG(keys.size() == indices.size(), "There must be an index for every key.");
+    QZ_ASSERT_MSG(keys.empty() || keys.size() - 1 <= std::numeric_limits<Index>::max(),
+                  "The index type is too small for the number of keys.");
+    std::vector<Key> copy(keys.begin(), keys.end());
+    std::iota(indices.begin(), indices.end(), Index{0});
+    detail::radix_sort<Key, Index>(copy.data(), indices.data(), copy.size(), thread_count);
+}
+
+///
+/// @}
+///
+
+} // namespace qz
@@ -0,0 +1,467 @@
+#pragma once
+
+#include <span>
+#include <type_traits>
+
+#include "quartz/array.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzRandom Pseudo-random number generation
+///
+/// @brief Small and fast pseudo-random number engines, and functions for turning their output into numbers in a range.
+/// @details The engines satisfy the `std::uniform_random_bit_generator` concept, so they also work with the
+/// distributions in <random>. Everything is constexpr, which allows seeding lookup tables at compile time. Include
+/// <quartz/random.hpp> to use these features.
+///
+/// @{
+///
+
+/// @cond Undocumented
+namespace detail
+{
+
+[[nodiscard]] constexpr u64 rotl(u64 value, u32 shift)
+{
+    return (value << shift) | (value >> ((64U - shift) & 63U));
+}
+
+[[nodiscard]] constexpr u64 rotr(u64 value, u32 shift)
+{
+    return (value >> shift) | (value << ((64U - shift) & 63U));
+}
+
+// 128-bit unsigned integer, used for the pcg64 state and for 64x64 -> 128 bit multiplication.
+struct u128
+{
+    u64 hi;
+    u64 lo;
+
+    [[nodiscard]] friend constexpr u128 operator+(u128 a, u128 b)
+    {
+        const u64 lo = a.lo + b.lo;
+        return {.hi = a.hi + b.hi + static_cast<u64>(lo < a.lo), .lo = lo};
+    }
+
+    [[nodiscard]] friend constexpr u128 operator*(u128 a, u128 b)
+    {
+        auto product = mul_wide(a.lo, b.lo);
+        product.hi += a.hi * b.lo + a.lo * b.hi;
+        return product;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(u128 a, u128 b) = default;
+
+    [[nodiscard]] static constexpr u128 mul_wide(u64 a, u64 b)
+    {
+#if defined(__SIZEOF_INT128__)
+        const auto product = static_cast<unsigned __int128>(a) * b;
+        return {.hi = static_cast<u64>(product >> 64U), .lo = static_cast<u64>(product)};
+#else
+        const u64 a_lo = a & 0xFFFFFFFFU, a_hi = a >> 32U;
+        const u64 b_lo = b & 0xFFFFFFFFU, b_hi = b >> 32U;
+        const u64 lo_lo = a_lo * b_lo;
+        const u64 hi_lo = a_hi * b_lo;
+        const u64 lo_hi = a_lo * b_hi;
+        const u64 hi_hi = a_hi * b_hi;
+        const u64 cross = (lo_lo >> 32U) + (hi_lo & 0xFFFFFFFFU) + lo_hi;
+        return {.hi = hi_hi + (hi_lo >> 32U) + (cross >> 32U), .lo = (cross << 32U) | (lo_lo & 0xFFFFFFFFU)};
+#endif
+    }
+};
+
+} // namespace detail
+/// @endcond
+
+///
+/// @brief The SplitMix64 engine. Mostly used for expanding a single 64-bit seed into the state of other engines.
+///
+class splitmix64
+{
+  public:
+    using result_type = u64;
+
+    /// @brief Construct the engine with the given seed.
+    constexpr explicit splitmix64(u64 seed = 0) : m_state(seed)
+    {
+    }
+
+    /// @brief Generate the next 64-bit value.
+    constexpr result_type operator()()
+    {
+        u64 value = (m_state += 0x9E3779B97F4A7C15U);
+        value     = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9U;
+        value     = (value ^ (value >> 27U)) * 0x94D049BB133111EBU;
+        return value ^ (value >> 31U);
+    }
+
+    [[nodiscard]] static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    [[nodiscard]] static constexpr result_type max()
+    {
+        return ~result_type{0};
+    }
+
+  private:
+    u64 m_state;
+};
+
+///
+/// @brief The xoshiro256++ engine, with a 256-bit state and a period of 2^256 - 1.
+/// @details Uses 32 bytes of state, compared to the 5 KB of `std::mt19937_64`. jump() and long_jump() advance the
+/// engine by 2^128 and 2^192 steps respectively, which is used for creating non-overlapping streams for each thread.
+///
+class xoshiro256pp
+{
+  public:
+    using result_type = u64;
+
+    /// @brief Construct the engine, expanding the seed into the full state using qz::splitmix64.
+    constexpr explicit xoshiro256pp(u64 seed = 0)
+    {
+        splitmix64 expander(seed);
+        for (auto &word : m_state)
+        {
+            word = expander();
+        }
+    }
+
+    /// @brief Construct the engine from a full state. The state must not be all zeros.
+    constexpr explicit xoshiro256pp(const array<u64, 4> &state) : m_state(state)
+    {
+    }
+
+    /// @brief Generate the next 64-bit value.
+    constexpr result_type operator()()
+    {
+        auto &s            = m_state;
+        const u64 result   = detail::rotl(s[0] + s[3], 23) + s[0];
+        const u64 shifted  = s[1] << 17U;
+        s[2]              ^= s[0];
+        s[3]              ^= s[1];
+        s[1]              ^= s[2];
+        s[0]              ^= s[3];
+        s[2]              ^= shifted;
+        s[3]               = detail::rotl(s[3], 45);
+        return result;
+    }
+
+    /// @brief Advance the engine by 2^128 steps.
+    constexpr void jump()
+    {
+        constexpr array<u64, 4> polynomial{0x180EC6D33CFD0ABAU, 0xD5A61266F0C9392CU, 0xA9582618E03FC9AAU,
+                                           0x39ABDC4529B1661CU};
+        apply_jump(polynomial);
+    }
+
+    /// @brief Advance the engine by 2^192 steps.
+    constexpr void long_jump()
+    {
+        constexpr array<u64, 4> polynomial{0x76E15D3EFEFDCBBFU, 0xC5004E441C522FB3U, 0x77710069854EE241U,
+                                           0x39109BB02ACBE635U};
+        apply_jump(polynomial);
+    }
+
+    /// @brief Get the current state of the engine.
+    [[nodiscard]] constexpr const array<u64, 4> &state() const
+    {
+        return m_state;
+    }
+
+    [[nodiscard]] static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    [[nodiscard]] static constexpr result_type max()
+    {
+        return ~result_type{0};
+    }
+
+    [[nodiscard]] constexpr bool operator==(const xoshiro256pp &other) const
+    {
+        return m_state[0] == other.m_state[0] && m_state[1] == other.m_state[1] && m_state[2] == other.m_state[2] &&
+               m_state[3] == other.m_state[3];
+    }
+
+  private:
+    constexpr void apply_jump(const array<u64, 4> &polynomial)
+    {
+        array<u64, 4> state{};
+        for (auto word : polynomial)
+        {
+            for (u32 bit = 0; bit < 64; ++bit)
+            {
+                if ((word & (u64{1} << bit)) != 0)
+                {
+                    for (usz i = 0; i < 4; ++i)
+                    {
+                        state[i] ^= m_state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        m_state = state;
+    }
+
+    array<u64, 4> m_state{};
+};
+
+///
+/// @brief The PCG64 engine (XSL-RR output on a 128-bit linear congruential generator), with a period of 2^128.
+/// @details Different stream values select different, independent sequences. advance() jumps the engine forward by an
+/// arbitrary number of steps in O(log n).
+///
+class pcg64
+{
+  public:
+    using result_type = u64;
+
+    /// @brief Construct the engine with the given seed and stream.
+    constexpr explicit pcg64(u64 seed = 0, u64 stream = 0)
+    {
+        // same seeding procedure as pcg_setseq_128_srandom_r, shifting the whole 128-bit stream selector.
+        m_increment = {.hi = stream >> 63U, .lo = (stream << 1U) | 1U};
+        step();
+        m_state = m_state + detail::u128{.hi = 0, .lo = seed};
+        step();
+    }
+
+    /// @brief Generate the next 64-bit value.
+    constexpr result_type operator()()
+    {
+        step();
+        return detail::rotr(m_state.hi ^ m_state.lo, static_cast<u32>(m_state.hi >> 58U));
+    }
+
+    /// @brief Advance the engine by the given number of steps.
+    constexpr void advance(u64 steps)
+    {
+        // Brown, "Random Number Generation with Arbitrary Stride".
+        detail::u128 multiplier = lcg_multiplier;
+        detail::u128 increment  = m_increment;
+        detail::u128 acc_mult{.hi = 0, .lo = 1};
+        detail::u128 acc_plus{.hi = 0, .lo = 0};
+        while (steps > 0)
+        {
+            if ((steps & 1U) != 0)
+            {
+                acc_mult = acc_mult * multiplier;
+                acc_plus = acc_plus * multiplier + increment;
+            }
+            increment  = (multiplier + detail::u128{.hi = 0, .lo = 1}) * increment;
+            multiplier = multiplier * multiplier;
+            steps >>= 1U;
+        }
+        m_state = acc_mult * m_state + acc_plus;
+    }
+
+    [[nodiscard]] static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    [[nodiscard]] static constexpr result_type max()
+    {
+        return ~result_type{0};
+    }
+
+    [[nodiscard]] constexpr bool operator==(const pcg64 &other) const = default;
+
+  private:
+    constexpr void step()
+    {
+        m_state = m_state * lcg_multiplier + m_increment;
+    }
+
+    static constexpr detail::u128 lcg_multiplier{.hi = 0x2360ED051FC65DA4U, .lo = 0x4385DF649FCCF645U};
+
+    detail::u128 m_state{.hi = 0, .lo = 0};
+    detail::u128 m_increment{.hi = 0, .lo = 1};
+};
+
+///
+/// @brief A xoshiro256++ engine running multiple independent streams side by side, for filling buffers in bulk.
+/// @details The state is stored lane-wise (structure of arrays), so each step updates all lanes with the same
+/// instructions and compilers turn the lane loops into SIMD code (e.g. 4 lanes of 64 bits with AVX2). Lane `i` starts
+/// `i` jumps (2^128 steps each) ahead of a scalar qz::xoshiro256pp with the same seed, so the lanes never overlap.
+///
+/// @tparam Lanes The number of streams generated in parallel.
+///
+template <usz Lanes = 4>
+class xoshiro256pp_batch
+{
+    static_assert(Lanes > 0, "Batch engines need at least one lane.");
+
+  public:
+    using result_type = u64;
+
+    /// @brief Construct the engine, deriving the lanes from a scalar engine with the given seed.
+    constexpr explicit xoshiro256pp_batch(u64 seed = 0) : xoshiro256pp_batch(xoshiro256pp(seed))
+    {
+    }
+
+    /// @brief Construct the engine, deriving the lanes from the given scalar engine.
+    constexpr explicit xoshiro256pp_batch(xoshiro256pp engine)
+    {
+        for (usz lane = 0; lane < Lanes; ++lane)
+        {
+            for (usz word = 0; word < 4; ++word)
+            {
+                m_state[word][lane] = engine.state()[word];
+            }
+            engine.jump();
+        }
+    }
+
+    /// @brief Generate one value for every lane.
+    constexpr array<u64, Lanes> operator()()
+    {
+        array<u64, Lanes> result{};
+        step(result.data());
+        return result;
+    }
+
+    /// @brief Fill the buffer with random values. Consecutive values are taken from consecutive lanes.
+    constexpr void fill(std::span<u64> buffer)
+    {
+        usz pos = 0;
+        for (; pos + Lanes <= buffer.size(); pos += Lanes)
+        {
+            step(buffer.data() + pos);
+        }
+        if (pos < buffer.size())
+        {
+            u64 tail[Lanes];
+            step(tail);
+            for (usz lane = 0; pos < buffer.size(); ++pos, ++lane)
+            {
+                buffer[pos] = tail[lane];
+            }
+        }
+    }
+
+    /// @brief Fill the array with random values. Consecutive values are taken from consecutive lanes.
+    template <usz N>
+    constexpr void fill(array<u64, N> &buffer)
+    {
+        fill(std::span<u64>(buffer.data(), N));
+    }
+
+    [[nodiscard]] static constexpr usz lanes()
+    {
+        return Lanes;
+    }
+
+  private:
+    constexpr void step(u64 *out)
+    {
+        auto &[s0, s1, s2, s3] = m_state.m_data;
+        for (usz i = 0; i < Lanes; ++i)
+        {
+            const u64 sum = s0[i] + s3[i];
+            out[i]        = ((sum << 23U) | (sum >> 41U)) + s0[i];
+        }
+        for (usz i = 0; i < Lanes; ++i)
+        {
+            const u64 shifted  = s1[i] << 17U;
+            s2[i]             ^= s0[i];
+            s3[i]             ^= s1[i];
+            s1[i]             ^= s2[i];
+            s0[i]             ^= s3[i];
+            s2[i]             ^= shifted;
+            s3[i]              = (s3[i] << 45U) | (s3[i] >> 19U);
+        }
+    }
+
+    array<array<u64, Lanes>, 4> m_state{};
+};
+
+//
+
+///
+/// @brief Generate a uniformly distributed integer in the range [0, bound) without bias.
+/// @details Uses Lemire's nearly divisionless method: a single multiplication in the common case, and a division only
+/// when the result would otherwise be biased.
+///
+/// @param engine The random bit generator. Must produce uniformly distributed 64-bit values.
+/// @param bound The exclusive upper bound. Must not be zero.
+///
+template <class Engine>
+[[nodiscard]] constexpr u64 uniform_int(Engine &engine, u64 bound)
+{
+    static_assert(Engine::min() == 0 && Engine::max() == ~u64{0}, "The engine must produce 64-bit values.");
+
+    auto product = detail::u128::mul_wide(engine(), bound);
+    if (product.lo < bound)
+    {
+        const u64 threshold = (0 - bound) % bound;
+        while (product.lo < threshold)
+        {
+            product = detail::u128::mul_wide(engine(), bound);
+        }
+    }
+    return product.hi;
+}
+
+///
+/// @brief Generate a uniformly distributed integer in the range [min, max] without bias.
+/// @param engine The random bit generator. Must produce uniformly distributed 64-bit values.
+/// @param min The inclusive lower bound.
+/// @param max The inclusive upper bound. Must not be less than min.
+///
+template <class Engine, class T>
+    requires(std::is_integral_v<T>)
+[[nodiscard]] constexpr T uniform_int(Engine &engine, T min, T max)
+{
+    const u64 span = static_cast<u64>(max) - static_cast<u64>(min);
+    const u64 offset = span == ~u64{0} ? engine() : uniform_int(engine, span + 1);
+    return static_cast<T>(static_cast<u64>(min) + offset);
+}
+
+///
+/// @brief Generate a uniformly distributed floating point value in the range [0, 1).
+/// @details Uses the upper bits of a single 64-bit value as the mantissa, so every representable result on the
+/// 2^-24 (f32) or 2^-53 (f64) grid is equally likely.
+/// @tparam F The floating point type, either qz::f32 or qz::f64.
+/// @param engine The random bit generator. Must produce uniformly distributed 64-bit values.
+///
+template <class F, class Engine>
+    requires(std::is_same_v<F, f32> || std::is_same_v<F, f64>)
+[[nodiscard]] constexpr F uniform_real(Engine &engine)
+{
+    if constexpr (std::is_same_v<F, f32>)
+    {
+        return static_cast<f32>(engine() >> 40U) * 0x1.0p-24F;
+    }
+    else
+    {
+        return static_cast<f64>(engine() >> 11U) * 0x1.0p-53;
+    }
+}
+
+///
+/// @brief Generate a uniformly distributed floating point value in the range [min, max).
+/// @param engine The random bit generator. Must produce uniformly distributed 64-bit values.
+/// @param min The inclusive lower bound.
+/// @param max The exclusive upper bound.
+///
+template <class F, class Engine>
+    requires(std::is_same_v<F, f32> || std::is_same_v<F, f64>)
+[[nodiscard]] constexpr F uniform_real(Engine &engine, F min, F max)
+{
+    return min + uniform_real<F>(engine) * (max - min);
+}
+
+///
+/// @}
+///
+
+} // namespace qz
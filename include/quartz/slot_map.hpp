@@ -0,0 +1,518 @@
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include "quartz/array.hpp"
+#include "quartz/assert.hpp"
+#include "quartz/macros.hpp"
+#include "quartz/optional.hpp"
+#include "quartz/types.hpp"
+#include "quartz/utilities.hpp"
+
+#if !defined(QZ_NO_EXCEPTIONS)
+    #include <stdexcept>
+#endif
+
+namespace qz
+{
+
+///
+/// @ingroup QzContainers
+///
+/// @brief A generational handle referring to a value stored inside a qz::slot_map.
+/// @details A handle is made up of a slot index and the generation of that slot at the time of insertion. Erasing a
+/// value bumps the generation of its slot, so any handle still referring to the erased value is detected as stale.
+/// A default constructed handle never refers to a valid value.
+///
+struct slot_map_handle
+{
+    /// @brief The index of the slot that the handle refers to.
+    u32 index = 0;
+    /// @brief The generation of the slot at the time the handle was created. Zero is reserved for null handles.
+    u32 generation = 0;
+
+    /// @brief Pack the handle into a single 64-bit integer.
+    [[nodiscard]] constexpr u64 to_u64() const
+    {
+        return (static_cast<u64>(generation) << 32U) | index;
+    }
+
+    /// @brief Unpack a handle previously packed using to_u64().
+    /// @param value The packed handle value.
+    [[nodiscard]] static constexpr slot_map_handle from_u64(u64 value)
+    {
+        return {.index = static_cast<u32>(value), .generation = static_cast<u32>(value >> 32U)};
+    }
+
+    /// @brief True if the handle is not a null handle. Does not check if the handle is still valid in any slot map.
+    [[nodiscard]] constexpr explicit operator bool() const
+    {
+        return generation != 0;
+    }
+
+    [[nodiscard]] constexpr bool operator==(const slot_map_handle &other) const = default;
+};
+
+static_assert(sizeof(slot_map_handle) == sizeof(u64), "qz::slot_map_handle is expected to be 8-bytes large.");
+
+/// @cond Undocumented
+namespace detail
+{
+
+// Fixed capacity storage used by qz::fixed_slot_map<T, N>.
+template <class T, usz N>
+struct slot_map_storage
+{
+    static_assert(std::is_default_constructible_v<T>, "Fixed capacity slot maps require default constructible types.");
+
+    [[nodiscard]] constexpr usz size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] static constexpr usz capacity()
+    {
+        return N;
+    }
+
+    [[nodiscard]] constexpr T *data()
+    {
+        return m_data.data();
+    }
+
+    [[nodiscard]] constexpr const T *data() const
+    {
+        return m_data.data();
+    }
+
+    template <class... Args>
+    constexpr T &emplace_back(Args &&...args)
+    {
+        QZ_VERIFY_MSG(m_size < N, "Fixed capacity slot map is full.");
+        m_data[m_size] = T(static_cast<Args &&>(args)...);
+        return m_data[m_size++];
+    }
+
+    constexpr void pop_back()
+    {
+        m_data[--m_size] = T();
+    }
+
+    constexpr void clear()
+    {
+        m_data.fill(T());
+        m_size = 0;
+    }
+
+    array<T, N> m_data{};
+    usz m_size = 0;
+};
+
+template <class T>
+struct slot_map_storage<T, 0>
+{
+    [[nodiscard]] constexpr usz size() const
+    {
+        return m_data.size();
+    }
+
+    [[nodiscard]] constexpr usz capacity() const
+    {
+        return m_data.capacity();
+    }
+
+    [[nodiscard]] constexpr T *data()
+    {
+        return m_data.data();
+    }
+
+    [[nodiscard]] constexpr const T *data() const
+    {
+        return m_data.data();
+    }
+
+    template <class... Args>
+    constexpr T &emplace_back(Args &&...args)
+    {
+        return m_data.emplace_back(static_cast<Args &&>(args)...);
+    }
+
+    constexpr void pop_back()
+    {
+        m_data.pop_back();
+    }
+
+    constexpr void clear()
+    {
+        m_data.clear();
+    }
+
+    constexpr void reserve(usz capacity)
+    {
+        m_data.reserve(capacity);
+    }
+
+    std::vector<T> m_data;
+};
+
+struct slot_map_slot
+{
+    // index into the dense value array while occupied, index of the next free slot while vacant.
+    u32 index_or_next;
+    u32 generation;
+};
+
+} // namespace detail
+/// @endcond
+
+///
+/// @ingroup QzContainers
+///
+/// @brief An associative container which hands out generational handles for the values stored in it.
+/// @details Values are kept densely packed in a contiguous array, so iterating over a slot map is as cache friendly as
+/// iterating over an array. Insertion and erasure are O(1); erasing moves the last value into the hole left behind.
+/// Lookups go through a slot table, which maps a handle to the current position of its value, and reject handles
+/// whose values have already been erased.
+///
+/// @tparam T The value type.
+/// @tparam N The fixed capacity of the slot map. A capacity of zero means that the storage grows on the heap.
+///
+/// @note Iteration order is unspecified and changes after erasing. Pointers and iterators to values are invalidated
+/// by insertion (for growable slot maps) and erasure, but handles are not.
+///
+template <class T, usz N = 0>
+class basic_slot_map
+{
+  public:
+    // TYPEDEFS
+
+    using value_type      = T;
+    using handle_type     = slot_map_handle;
+    using size_type       = usz;
+    using difference_type = ssz;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using pointer         = value_type *;
+    using const_pointer   = const value_type *;
+    using iterator        = pointer;
+    using const_iterator  = const_pointer;
+
+    // METHODS
+
+    /// @brief Construct a new value inside the slot map.
+    /// @details Inserting into a full slot map reports the failure and terminates, in release builds as well.
+    /// @param args The arguments forwarded to the constructor of the value.
+    /// @return The handle referring to the newly inserted value.
+    template <class... Args>
+    constexpr handle_type emplace(Args &&...args)
+    {
+        QZ_VERIFY_MSG(!full(), "Slot map is full.");
+
+        u32 slot_index = m_free_head;
+        if (slot_index == free_list_end)
+        {
+            slot_index = static_cast<u32>(m_slots.size());
+            m_slots.emplace_back(detail::slot_map_slot{.index_or_next = 0, .generation = 0});
+        }
+        else
+        {
+            m_free_head = m_slots.data()[slot_index].index_or_next;
+        }
+
+        m_values.emplace_back(static_cast<Args &&>(args)...);
+        m_dense_to_slot.emplace_back(slot_index);
+
+        auto &slot         = m_slots.data()[slot_index];
+        slot.index_or_next = static_cast<u32>(m_values.size() - 1);
+        slot.generation    = next_generation(slot.generation);
+
+        return {.index = slot_index, .generation = slot.generation};
+    }
+
+    /// @brief Insert a copy of a value into the slot map.
+    /// @return The handle referring to the newly inserted value.
+    constexpr handle_type insert(const value_type &value)
+    {
+        return emplace(value);
+    }
+
+    /// @brief Insert a value into the slot map by moving it.
+    /// @return The handle referring to the newly inserted value.
+    constexpr handle_type insert(value_type &&value)
+    {
+        return emplace(qz::move(value));
+    }
+
+    /// @brief Erase the value referred to by the given handle.
+    /// @param handle The handle of the value being erased.
+    /// @return True if a value was erased, false if the handle was stale or null.
+    constexpr bool erase(handle_type handle)
+    {
+        if (!contains(handle))
+        {
+            return false;
+        }
+
+        auto &slot        = m_slots.data()[handle.index];
+        const auto dense  = slot.index_or_next;
+        const auto last   = static_cast<u32>(m_values.size() - 1);
+        auto *values      = m_values.data();
+        auto *dense_slots = m_dense_to_slot.data();
+
+        if (dense != last)
+        {
+            values[dense]      = qz::move(values[last]);
+            dense_slots[dense] = dense_slots[last];
+            m_slots.data()[dense_slots[dense]].index_or_next = dense;
+        }
+        m_values.pop_back();
+        m_dense_to_slot.pop_back();
+
+        slot.generation    = next_generation(slot.generation);
+        slot.index_or_next = m_free_head;
+        m_free_head        = handle.index;
+        return true;
+    }
+
+    /// @brief Erase all values from the slot map. All existing handles become stale.
+    constexpr void clear()
+    {
+        auto *slots = m_slots.data();
+        for (usz i = 0; i < m_dense_to_slot.size(); ++i)
+        {
+            auto &slot         = slots[m_dense_to_slot.data()[i]];
+            slot.generation    = next_generation(slot.generation);
+            slot.index_or_next = m_free_head;
+            m_free_head        = m_dense_to_slot.data()[i];
+        }
+        m_values.clear();
+        m_dense_to_slot.clear();
+    }
+
+    /// @brief Reserve storage for at least the given number of values. Only available for growable slot maps.
+    /// @param capacity The number of values to reserve storage for.
+    constexpr void reserve(size_type capacity)
+        requires(N == 0)
+    {
+        m_values.reserve(capacity);
+        m_dense_to_slot.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    /// @brief True if the handle refers to a value currently stored in this slot map.
+    /// @details Matching generations are not enough, since handles may be forged with from_u64() and generations
+    /// wrap around. The slot must also be occupied, i.e. point at a value which points back at it.
+    [[nodiscard]] constexpr bool contains(handle_type handle) const
+    {
+        if (handle.index >= m_slots.size() || handle.generation == 0)
+        {
+            return false;
+        }
+        const auto &slot = m_slots.data()[handle.index];
+        return slot.generation == handle.generation && slot.index_or_next < m_values.size() &&
+               m_dense_to_slot.data()[slot.index_or_next] == handle.index;
+    }
+
+    /// @brief Get a pointer to the value referred to by the handle.
+    /// @return A pointer to the value, or nullptr if the handle is stale or null.
+    [[nodiscard]] constexpr pointer find(handle_type handle)
+    {
+        return contains(handle) ? m_values.data() + m_slots.data()[handle.index].index_or_next : nullptr;
+    }
+
+    /// @brief Get a const pointer to the value referred to by the handle.
+    /// @return A const pointer to the value, or nullptr if the handle is stale or null.
+    [[nodiscard]] constexpr const_pointer find(handle_type handle) const
+    {
+        return contains(handle) ? m_values.data() + m_slots.data()[handle.index].index_or_next : nullptr;
+    }
+
+    /// @brief Get a reference to the value referred to by the handle.
+    /// @param handle The handle of the value. If stale or null, throws an exception (or reports an assertion
+    /// failure when built with QZ_NO_EXCEPTIONS).
+    [[nodiscard]] constexpr reference at(handle_type handle)
+    {
+        if (!contains(handle))
+        {
+            QZ_THROW(std::out_of_range, "Stale or null slot map handle.");
+        }
+        return m_values.data()[m_slots.data()[handle.index].index_or_next];
+    }
+
+    /// @brief Get a const reference to the value referred to by the handle.
+    /// @param handle The handle of the value. If stale or null, throws an exception (or reports an assertion
+    /// failure when built with QZ_NO_EXCEPTIONS).
+    [[nodiscard]] constexpr const_reference at(handle_type handle) const
+    {
+        if (!contains(handle))
+        {
+            QZ_THROW(std::out_of_range, "Stale or null slot map handle.");
+        }
+        return m_values.data()[m_slots.data()[handle.index].index_or_next];
+    }
+
+    /// @brief Get an optional reference to the value referred to by the handle.
+    /// @param handle The handle of the value. If stale or null, an empty optional is returned.
+    [[nodiscard]] constexpr optional<reference> try_at(handle_type handle)
+    {
+        auto *value = find(handle);
+        return value != nullptr ? optional<reference>(*value) : nullopt;
+    }
+
+    /// @brief Get an optional const reference to the value referred to by the handle.
+    /// @param handle The handle of the value. If stale or null, an empty optional is returned.
+    [[nodiscard]] constexpr optional<const_reference> try_at(handle_type handle) const
+    {
+        const auto *value = find(handle);
+        return value != nullptr ? optional<const_reference>(*value) : nullopt;
+    }
+
+    /// @brief Get the handle of the value at the given position of the dense value array.
+    /// @param pos The position of the value, i.e. its distance from begin(). No bounds checking is done.
+    [[nodiscard]] constexpr handle_type handle_at(size_type pos) const
+    {
+        const auto slot_index = m_dense_to_slot.data()[pos];
+        return {.index = slot_index, .generation = m_slots.data()[slot_index].generation};
+    }
+
+    /// @brief Get a pointer to the dense value array.
+    [[nodiscard]] constexpr pointer data()
+    {
+        return m_values.data();
+    }
+
+    /// @brief Get a const pointer to the dense value array.
+    [[nodiscard]] constexpr const_pointer data() const
+    {
+        return m_values.data();
+    }
+
+    /// @brief True if there are no values in the slot map, else false.
+    [[nodiscard]] constexpr bool empty() const
+    {
+        return m_values.size() == 0;
+    }
+
+    /// @brief True if no more values can be inserted into the slot map, else false.
+    [[nodiscard]] constexpr bool full() const
+    {
+        if constexpr (N == 0)
+        {
+            return m_values.size() == max_size();
+        }
+        else
+        {
+            return m_values.size() == N;
+        }
+    }
+
+    /// @brief Get the number of values in the slot map.
+    [[nodiscard]] constexpr size_type size() const
+    {
+        return m_values.size();
+    }
+
+    /// @brief Get the number of values that may be stored without growing the storage.
+    [[nodiscard]] constexpr size_type capacity() const
+    {
+        return m_values.capacity();
+    }
+
+    /// @brief Get the maximum number of values that may fit into the slot map.
+    [[nodiscard]] constexpr size_type max_size() const
+    {
+        return N == 0 ? static_cast<size_type>(free_list_end - 1) : N;
+    }
+
+    /// @brief Get an iterator to the beginning of the dense value array.
+    [[nodiscard]] constexpr iterator begin()
+    {
+        return data();
+    }
+
+    /// @brief Get a const iterator to the beginning of the dense value array.
+    [[nodiscard]] constexpr const_iterator begin() const
+    {
+        return cbegin();
+    }
+
+    /// @brief Get a const iterator to the beginning of the dense value array.
+    [[nodiscard]] constexpr const_iterator cbegin() const
+    {
+        return data();
+    }
+
+    /// @brief Get an iterator past the last element of the dense value array.
+    [[nodiscard]] constexpr iterator end()
+    {
+        return data() + size();
+    }
+
+    /// @brief Get a const iterator past the last element of the dense value array.
+    [[nodiscard]] constexpr const_iterator end() const
+    {
+        return cend();
+    }
+
+    /// @brief Get a const iterator past the last element of the dense value array.
+    [[nodiscard]] constexpr const_iterator cend() const
+    {
+        return data() + size();
+    }
+
+    // OPERATOR OVERLOADS
+
+    /// @brief Get a reference to the value referred to by the handle.
+    /// @param handle The handle of the value. Only checked for staleness in debug builds.
+    [[nodiscard]] constexpr reference operator[](handle_type handle)
+    {
+        QZ_ASSERT_MSG(contains(handle), "Stale or null slot map handle.");
+        return m_values.data()[m_slots.data()[handle.index].index_or_next];
+    }
+
+    /// @brief Get a const reference to the value referred to by the handle.
+    /// @param handle The handle of the value. Only checked for staleness in debug builds.
+    [[nodiscard]] constexpr const_reference operator[](handle_type handle) const
+    {
+        QZ_ASSERT_MSG(contains(handle), "Stale or null slot map handle.");
+        return m_values.data()[m_slots.data()[handle.index].index_or_next];
+    }
+
+  private:
+    // generations skip zero when wrapping around so that null handles never become valid.
+    [[nodiscard]] static constexpr u32 next_generation(u32 generation)
+    {
+        return generation == ~u32{0} ? 1 : generation + 1;
+    }
+
+    static constexpr u32 free_list_end = ~u32{0};
+
+    detail::slot_map_storage<T, N> m_values;
+    detail::slot_map_storage<u32, N> m_dense_to_slot;
+    detail::slot_map_storage<detail::slot_map_slot, N> m_slots;
+    u32 m_free_head = free_list_end;
+};
+
+///
+/// @ingroup QzContainers
+///
+/// @brief A growable slot map which stores its values on the heap.
+/// @tparam T The value type.
+///
+template <class T>
+using slot_map = basic_slot_map<T, 0>;
+
+///
+/// @ingroup QzContainers
+///
+/// @brief A fixed capacity slot map backed by qz::array which never allocates.
+/// @details Check full() before inserting, inserting into a full map terminates the program.
+/// @tparam T The value type. Must be default constructible.
+/// @tparam N The maximum number of values stored in the slot map.
+///
+template <class T, usz N>
+    requires(N > 0)
+using fixed_slot_map = basic_slot_map<T, N>;
+
+} // namespace qz
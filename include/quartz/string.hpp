@@ -0,0 +1,568 @@
+#pragma once
+
+#include <bit>
+#include <compare>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+#include "quartz/assert.hpp"
+#include "quartz/types.hpp"
+#include "quartz/utilities.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzStrings Strings
+/// @brief String types avoiding heap allocations for short strings. Include <quartz/string.hpp> to use them.
+/// @{
+///
+
+///
+/// @brief A string of a fixed length, usable in constant expressions and as a template argument.
+/// @details The string is a structural type, so it may be passed as a non-type template parameter, e.g.
+/// `template <qz::fixed_string Name> struct tag {};` instantiated as `tag<"name">`. String literals deduce the length
+/// without the null terminator, which is still stored so that c_str() works.
+///
+/// @tparam N The length of the string, excluding the null terminator.
+///
+template <usz N>
+struct fixed_string
+{
+    // TYPEDEFS
+
+    using value_type      = char;
+    using size_type       = usz;
+    using const_reference = const char &;
+    using const_pointer   = const char *;
+    using const_iterator  = const char *;
+
+    // CONSTRUCTORS
+
+    constexpr fixed_string() = default;
+
+    /// @brief Construct the string from a string literal.
+    constexpr fixed_string(const char (&string)[N + 1]) // NOLINT (implicit conversion)
+    {
+        for (usz i = 0; i < N; ++i)
+        {
+            chars[i] = string[i];
+        }
+    }
+
+    // METHODS
+
+    /// @brief Get the length of the string.
+    [[nodiscard]] static constexpr size_type size()
+    {
+        return N;
+    }
+
+    /// @brief True if the string has no characters, else false.
+    [[nodiscard]] static constexpr bool empty()
+    {
+        return N == 0;
+    }
+
+    /// @brief Get a pointer to the characters of the string.
+    [[nodiscard]] constexpr const_pointer data() const
+    {
+        return chars;
+    }
+
+    /// @brief Get a pointer to the null terminated characters of the string.
+    [[nodiscard]] constexpr const_pointer c_str() const
+    {
+        return chars;
+    }
+
+    /// @brief Get a view over the characters of the string.
+    [[nodiscard]] constexpr std::string_view view() const
+    {
+        return {chars, N};
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const
+    {
+        return chars;
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const
+    {
+        return chars + N;
+    }
+
+    // OPERATOR OVERLOADS
+
+    /// @brief Get the character at the given position. Only checked in debug builds.
+    [[nodiscard]] constexpr const_reference operator[](size_type pos) const
+    {
+        QZ_ASSERT_MSG(pos < N, "Index out of bounds access.");
+        return chars[pos];
+    }
+
+    [[nodiscard]] constexpr operator std::string_view() const // NOLINT (implicit conversion)
+    {
+        return view();
+    }
+
+    /// @brief Concatenate two fixed strings.
+    template <usz M>
+    [[nodiscard]] constexpr fixed_string<N + M> operator+(const fixed_string<M> &other) const
+    {
+        fixed_string<N + M> result;
+        for (usz i = 0; i < N; ++i)
+        {
+            result.chars[i] = chars[i];
+        }
+        for (usz i = 0; i < M; ++i)
+        {
+            result.chars[N + i] = other.chars[i];
+        }
+        return result;
+    }
+
+    template <usz M>
+    [[nodiscard]] constexpr bool operator==(const fixed_string<M> &other) const
+    {
+        return view() == other.view();
+    }
+
+    template <usz M>
+    [[nodiscard]] constexpr std::strong_ordering operator<=>(const fixed_string<M> &other) const
+    {
+        return view() <=> other.view();
+    }
+
+    // DATA MEMBERS
+
+    /// @brief The null terminated characters of the string. Made public so that the string is a structural type.
+    char chars[N + 1] = {};
+};
+
+/// @brief Type deduction guide for qz::fixed_string, dropping the null terminator of string literals.
+template <usz N>
+fixed_string(const char (&)[N]) -> fixed_string<N - 1>;
+
+///
+/// @brief A string storing up to 23 characters inline, and allocating through the given allocator beyond that.
+/// @details The string takes 24 bytes with a stateless allocator, the same as three pointers. Short strings are
+/// stored inline with their remaining inline capacity in the last byte, which doubles as the null terminator when all
+/// 23 characters are used. Long strings store a pointer, size and capacity, with the top bit of the last byte marking
+/// the heap representation. The string is always null terminated.
+///
+/// @tparam Allocator The allocator used for strings which do not fit inline. Rebound to `char`.
+///
+template <class Allocator = std::allocator<char>>
+class basic_small_string
+{
+    using allocator_traits = typename std::allocator_traits<Allocator>::template rebind_traits<char>;
+
+  public:
+    // TYPEDEFS
+
+    using value_type      = char;
+    using allocator_type  = typename allocator_traits::allocator_type;
+    using size_type       = usz;
+    using reference       = char &;
+    using const_reference = const char &;
+    using pointer         = char *;
+    using const_pointer   = const char *;
+    using iterator        = char *;
+    using const_iterator  = const char *;
+
+    /// @brief The number of characters stored without allocating.
+    static constexpr size_type inline_capacity = 3 * sizeof(usz) - 1;
+
+    // CONSTRUCTORS & DESTRUCTOR
+
+    basic_small_string() noexcept(noexcept(allocator_type())) : basic_small_string(allocator_type())
+    {
+    }
+
+    explicit basic_small_string(const allocator_type &allocator) noexcept : m_allocator(allocator)
+    {
+        set_inline_size(0);
+    }
+
+    /// @brief Construct the string from a copy of the given characters.
+    explicit basic_small_string(std::string_view string, const allocator_type &allocator = allocator_type())
+        : basic_small_string(allocator)
+    {
+        append(string);
+    }
+
+    /// @brief Construct the string from a copy of the given null terminated characters.
+    basic_small_string(const char *string, const allocator_type &allocator = allocator_type()) // NOLINT (implicit)
+        : basic_small_string(std::string_view(string), allocator)
+    {
+    }
+
+    /// @brief Construct the string from the given character repeated count times.
+    basic_small_string(size_type count, char ch, const allocator_type &allocator = allocator_type())
+        : basic_small_string(allocator)
+    {
+        resize(count, ch);
+    }
+
+    basic_small_string(const basic_small_string &other)
+        : basic_small_string(other.view(),
+                             allocator_traits::select_on_container_copy_construction(other.m_allocator))
+    {
+    }
+
+    basic_small_string(basic_small_string &&other) noexcept
+        : m_rep(other.m_rep), m_allocator(qz::move(other.m_allocator))
+    {
+        other.set_inline_size(0);
+    }
+
+    basic_small_string &operator=(const basic_small_string &other)
+    {
+        if (this != &other)
+        {
+            assign(other.view());
+        }
+        return *this;
+    }
+
+    basic_small_string &operator=(basic_small_string &&other) noexcept
+    {
+        if (this != &other)
+        {
+            deallocate();
+            m_rep       = other.m_rep;
+            m_allocator = qz::move(other.m_allocator);
+            other.set_inline_size(0);
+        }
+        return *this;
+    }
+
+    basic_small_string &operator=(std::string_view string)
+    {
+        assign(string);
+        return *this;
+    }
+
+    basic_small_string &operator=(const char *string)
+    {
+        assign(string);
+        return *this;
+    }
+
+    ~basic_small_string()
+    {
+        deallocate();
+    }
+
+    // METHODS
+
+    /// @brief Replace the contents of the string with a copy of the given characters.
+    void assign(std::string_view string)
+    {
+        reserve(string.size());
+        if (!string.empty())
+        {
+            std::memmove(data(), string.data(), string.size());
+        }
+        set_size(string.size());
+    }
+
+    /// @brief Append a copy of the given characters to the end of the string.
+    basic_small_string &append(std::string_view string)
+    {
+        const auto old_size = size();
+        const auto new_size = old_size + string.size();
+        if (new_size > capacity())
+        {
+            // the characters may point into this string, so they are copied before the old storage is released.
+            reallocate(new_size > 2 * capacity() ? new_size : 2 * capacity(), string);
+        }
+        else if (!string.empty())
+        {
+            std::memmove(data() + old_size, string.data(), string.size());
+        }
+        set_size(new_size);
+        return *this;
+    }
+
+    /// @brief Append the given character to the end of the string.
+    void push_back(char ch)
+    {
+        const auto old_size = size();
+        grow_to(old_size + 1);
+        data()[old_size] = ch;
+        set_size(old_size + 1);
+    }
+
+    /// @brief Remove the last character of the string. Only checked in debug builds.
+    void pop_back()
+    {
+        QZ_ASSERT_MSG(!empty(), "Popping the last character of an empty string.");
+        set_size(size() - 1);
+    }
+
+    /// @brief Resize the string to the given length, filling new characters with the given character.
+    void resize(size_type count, char ch = '\0')
+    {
+        const auto old_size = size();
+        if (count > old_size)
+        {
+            grow_to(count);
+            std::memset(data() + old_size, ch, count - old_size);
+        }
+        set_size(count);
+    }
+
+    /// @brief Resize the string to the given length, leaving new characters uninitialized.
+    /// @details Useful for writing into the string directly, e.g. through qz::format_to.
+    void resize_uninitialized(size_type count)
+    {
+        grow_to(count);
+        set_size(count);
+    }
+
+    /// @brief Ensure the string has room for at least the given number of characters without reallocating.
+    void reserve(size_type new_capacity)
+    {
+        if (new_capacity > capacity())
+        {
+            reallocate(new_capacity);
+        }
+    }
+
+    /// @brief Remove all characters of the string. Keeps the current capacity.
+    void clear() noexcept
+    {
+        set_size(0);
+    }
+
+    /// @brief Get the length of the string.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return is_inline() ? inline_capacity - tag() : m_rep.heap.size;
+    }
+
+    /// @brief Get the number of characters the string can hold without reallocating.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return is_inline() ? inline_capacity : decode_capacity(m_rep.heap.capacity);
+    }
+
+    /// @brief True if the string has no characters, else false.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /// @brief True if the characters are stored inline, false if they are stored on the heap.
+    [[nodiscard]] bool is_inline() const noexcept
+    {
+        return (tag() & heap_tag) == 0;
+    }
+
+    /// @brief Get a pointer to the characters of the string.
+    [[nodiscard]] pointer data() noexcept
+    {
+        return is_inline() ? m_rep.chars : m_rep.heap.data;
+    }
+
+    /// @brief Get a pointer to the characters of the string.
+    [[nodiscard]] const_pointer data() const noexcept
+    {
+        return is_inline() ? m_rep.chars : m_rep.heap.data;
+    }
+
+    /// @brief Get a pointer to the null terminated characters of the string.
+    [[nodiscard]] const_pointer c_str() const noexcept
+    {
+        return data();
+    }
+
+    /// @brief Get a view over the characters of the string.
+    [[nodiscard]] std::string_view view() const noexcept
+    {
+        return {data(), size()};
+    }
+
+    /// @brief Get a copy of the allocator.
+    [[nodiscard]] allocator_type get_allocator() const
+    {
+        return m_allocator;
+    }
+
+    [[nodiscard]] iterator begin() noexcept
+    {
+        return data();
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        return data();
+    }
+
+    [[nodiscard]] iterator end() noexcept
+    {
+        return data() + size();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return data() + size();
+    }
+
+    // OPERATOR OVERLOADS
+
+    /// @brief Get the character at the given position. Only checked in debug builds.
+    [[nodiscard]] reference operator[](size_type pos)
+    {
+        QZ_ASSERT_MSG(pos < size(), "Index out of bounds access.");
+        return data()[pos];
+    }
+
+    /// @brief Get the character at the given position. Only checked in debug builds.
+    [[nodiscard]] const_reference operator[](size_type pos) const
+    {
+        QZ_ASSERT_MSG(pos < size(), "Index out of bounds access.");
+        return data()[pos];
+    }
+
+    [[nodiscard]] operator std::string_view() const noexcept // NOLINT (implicit conversion)
+    {
+        return view();
+    }
+
+    basic_small_string &operator+=(std::string_view string)
+    {
+        return append(string);
+    }
+
+    basic_small_string &operator+=(char ch)
+    {
+        push_back(ch);
+        return *this;
+    }
+
+    [[nodiscard]] friend bool operator==(const basic_small_string &lhs, std::string_view rhs) noexcept
+    {
+        return lhs.view() == rhs;
+    }
+
+    [[nodiscard]] friend std::strong_ordering operator<=>(const basic_small_string &lhs, std::string_view rhs) noexcept
+    {
+        return lhs.view() <=> rhs;
+    }
+
+  private:
+    // the top bit of the last byte is set for the heap representation. on big endian targets, the capacity is shifted
+    // up by a byte to leave the last byte for the tag.
+    static constexpr u8 heap_tag = 0x80;
+
+    [[nodiscard]] static constexpr usz encode_capacity(usz capacity)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            return capacity | (usz{heap_tag} << (8 * (sizeof(usz) - 1)));
+        }
+        else
+        {
+            return (capacity << 8) | heap_tag;
+        }
+    }
+
+    [[nodiscard]] static constexpr usz decode_capacity(usz encoded)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            return encoded & ~(usz{heap_tag} << (8 * (sizeof(usz) - 1)));
+        }
+        else
+        {
+            return encoded >> 8;
+        }
+    }
+
+    [[nodiscard]] u8 tag() const noexcept
+    {
+        return static_cast<u8>(m_rep.chars[inline_capacity]);
+    }
+
+    void set_inline_size(size_type size) noexcept
+    {
+        m_rep.chars[size]            = '\0';
+        m_rep.chars[inline_capacity] = static_cast<char>(inline_capacity - size);
+    }
+
+    void set_size(size_type size) noexcept
+    {
+        if (is_inline())
+        {
+            set_inline_size(size);
+        }
+        else
+        {
+            m_rep.heap.size       = size;
+            m_rep.heap.data[size] = '\0';
+        }
+    }
+
+    void grow_to(size_type required)
+    {
+        const auto current = capacity();
+        if (required > current)
+        {
+            reallocate(required > 2 * current ? required : 2 * current);
+        }
+    }
+
+    void reallocate(size_type new_capacity, std::string_view suffix = {})
+    {
+        const auto old_size = size();
+        auto *new_data      = allocator_traits::allocate(m_allocator, new_capacity + 1);
+        std::memcpy(new_data, data(), old_size);
+        if (!suffix.empty())
+        {
+            std::memcpy(new_data + old_size, suffix.data(), suffix.size());
+        }
+        new_data[old_size + suffix.size()] = '\0';
+        deallocate();
+        m_rep.heap.data     = new_data;
+        m_rep.heap.size     = old_size + suffix.size();
+        m_rep.heap.capacity = encode_capacity(new_capacity);
+    }
+
+    void deallocate() noexcept
+    {
+        if (!is_inline())
+        {
+            allocator_traits::deallocate(m_allocator, m_rep.heap.data, decode_capacity(m_rep.heap.capacity) + 1);
+        }
+    }
+
+    struct heap_rep
+    {
+        char *data;
+        usz size;
+        usz capacity;
+    };
+
+    union rep {
+        heap_rep heap;
+        char chars[inline_capacity + 1];
+    };
+
+    static_assert(sizeof(heap_rep) == inline_capacity + 1);
+
+    rep m_rep{};
+    [[no_unique_address]] allocator_type m_allocator;
+};
+
+/// @brief A small string using the default allocator.
+using small_string = basic_small_string<>;
+
+///
+/// @}
+///
+
+} // namespace qz
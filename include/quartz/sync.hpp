@@ -0,0 +1,330 @@
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "quartz/hardware.hpp"
+#include "quartz/types.hpp"
+
+namespace qz
+{
+
+///
+/// @defgroup QzSync Synchronization primitives
+///
+/// @brief Lightweight locks for guarding very short critical sections.
+/// @details All lock types satisfy the standard `Lockable` requirements, so they can be used with `std::lock_guard`,
+/// `std::unique_lock` and `std::scoped_lock`. The reader-writer lock additionally satisfies the `SharedLockable`
+/// requirements for use with `std::shared_lock`. Include <quartz/sync.hpp> to use these features.
+///
+/// @{
+///
+
+/// @cond Undocumented
+namespace detail
+{
+
+// block the calling thread while the value of the word equals the expected value. may return spuriously.
+void futex_wait(std::atomic<u32> &word, u32 expected);
+// wake up a single thread blocked on the word.
+void futex_wake_one(std::atomic<u32> &word);
+
+// exponential backoff for spin-wait loops.
+class spin_backoff
+{
+  public:
+    void pause()
+    {
+        for (u32 i = 0; i < m_count; ++i)
+        {
+            cpu_pause();
+        }
+        m_count = m_count < max_count ? m_count * 2 : max_count;
+    }
+
+  private:
+    static constexpr u32 max_count = 64;
+
+    u32 m_count = 1;
+};
+
+} // namespace detail
+/// @endcond
+
+///
+/// @brief A test-and-test-and-set spinlock with exponential backoff.
+/// @details Waiting threads spin on a plain load rather than on the atomic exchange, so the cache line is only
+/// written to when the lock looks free. The lock occupies a whole cache line to avoid false sharing with neighbouring
+/// data. Best suited for critical sections that are only a handful of instructions long.
+///
+class alignas(cache_line_size) spinlock
+{
+  public:
+    /// @brief Acquire the lock, spinning until it becomes available.
+    void lock()
+    {
+        detail::spin_backoff backoff;
+        while (m_locked.exchange(true, std::memory_order_acquire))
+        {
+            while (m_locked.load(std::memory_order_relaxed))
+            {
+                backoff.pause();
+            }
+        }
+    }
+
+    /// @brief Try to acquire the lock without spinning.
+    /// @return True if the lock was acquired, else false.
+    [[nodiscard]] bool try_lock()
+    {
+        return !m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    /// @brief Release the lock.
+    void unlock()
+    {
+        m_locked.store(false, std::memory_order_release);
+    }
+
+  private:
+    std::atomic<bool> m_locked = false;
+};
+
+static_assert(sizeof(spinlock) == cache_line_size, "qz::spinlock is expected to occupy a single cache line.");
+
+///
+/// @brief A 4-byte mutex which puts waiting threads to sleep using the operating system's futex facility.
+/// @details Uncontended locking and unlocking is a single atomic instruction. Under contention the lock spins for a
+/// short while before sleeping, and unlocking only makes a system call when there are sleeping waiters. Uses `futex`
+/// on Linux and `WaitOnAddress` on Windows.
+///
+class mutex
+{
+  public:
+    /// @brief Acquire the lock, blocking until it becomes available.
+    void lock()
+    {
+        u32 state = unlocked;
+        if (!m_state.compare_exchange_strong(state, locked, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            lock_contended();
+        }
+    }
+
+    /// @brief Try to acquire the lock without blocking.
+    /// @return True if the lock was acquired, else false.
+    [[nodiscard]] bool try_lock()
+    {
+        u32 state = unlocked;
+        return m_state.compare_exchange_strong(state, locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /// @brief Release the lock, waking up one waiting thread if there are any.
+    void unlock()
+    {
+        if (m_state.exchange(unlocked, std::memory_order_release) == locked_contended)
+        {
+            detail::futex_wake_one(m_state);
+        }
+    }
+
+  private:
+    void lock_contended();
+
+    static constexpr u32 unlocked         = 0;
+    static constexpr u32 locked           = 1;
+    static constexpr u32 locked_contended = 2;
+
+    std::atomic<u32> m_state = unlocked;
+};
+
+static_assert(sizeof(mutex) == 4, "qz::mutex is expected to be 4-bytes large.");
+
+///
+/// @brief A 4-byte reader-writer spinlock.
+/// @details Any number of readers may hold the lock at the same time, while writers get exclusive access. A waiting
+/// writer stops new readers from entering, so writers are not starved by a steady stream of readers.
+///
+class rw_spinlock
+{
+  public:
+    /// @brief Acquire exclusive ownership of the lock, spinning until it becomes available.
+    void lock()
+    {
+        detail::spin_backoff backoff;
+        u32 state = m_state.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            // only the pending bit may be set (by this or another writer) when taking over the lock.
+            if ((state & ~writer_pending) == 0)
+            {
+                if (m_state.compare_exchange_weak(state, writer_locked, std::memory_order_acquire,
+                                                  std::memory_order_relaxed))
+                {
+                    return;
+                }
+                continue;
+            }
+            if ((state & writer_pending) == 0)
+            {
+                m_state.fetch_or(writer_pending, std::memory_order_relaxed);
+            }
+            backoff.pause();
+            state = m_state.load(std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Try to acquire exclusive ownership of the lock without spinning.
+    /// @return True if the lock was acquired, else false.
+    [[nodiscard]] bool try_lock()
+    {
+        u32 state = m_state.load(std::memory_order_relaxed);
+        return (state & ~writer_pending) == 0 &&
+               m_state.compare_exchange_strong(state, writer_locked, std::memory_order_acquire,
+                                               std::memory_order_relaxed);
+    }
+
+    /// @brief Release exclusive ownership of the lock.
+    void unlock()
+    {
+        m_state.fetch_and(~writer_locked, std::memory_order_release);
+    }
+
+    /// @brief Acquire shared ownership of the lock, spinning while a writer holds or waits for the lock.
+    void lock_shared()
+    {
+        detail::spin_backoff backoff;
+        while (!try_lock_shared())
+        {
+            backoff.pause();
+        }
+    }
+
+    /// @brief Try to acquire shared ownership of the lock without spinning.
+    /// @return True if the lock was acquired, else false.
+    [[nodiscard]] bool try_lock_shared()
+    {
+        u32 state = m_state.load(std::memory_order_relaxed);
+        while ((state & (writer_locked | writer_pending)) == 0)
+        {
+            if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Release shared ownership of the lock.
+    void unlock_shared()
+    {
+        m_state.fetch_sub(1, std::memory_order_release);
+    }
+
+  private:
+    static constexpr u32 writer_locked  = 1U << 31U;
+    static constexpr u32 writer_pending = 1U << 30U;
+
+    // the lower bits count the readers currently holding the lock.
+    std::atomic<u32> m_state = 0;
+};
+
+static_assert(sizeof(rw_spinlock) == 4, "qz::rw_spinlock is expected to be 4-bytes large.");
+
+///
+/// @brief A sequence lock protecting a trivially copyable value which is read far more often than it is written.
+/// @details Readers never write to shared memory; they copy the value optimistically and retry if a writer was active
+/// in the meantime. Writers are serialized among themselves and never wait for readers. The value is stored as an
+/// array of relaxed atomic words, so concurrent reads and writes are free of data races.
+///
+/// @tparam T The type of the protected value. Must be trivially copyable and default constructible.
+///
+template <class T>
+class seqlock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Values protected by qz::seqlock must be trivially copyable.");
+    static_assert(std::is_default_constructible_v<T>, "Values protected by qz::seqlock must be default constructible.");
+
+    static constexpr usz word_count = (sizeof(T) + sizeof(usz) - 1) / sizeof(usz);
+
+  public:
+    seqlock() : seqlock(T{})
+    {
+    }
+
+    /// @brief Construct the sequence lock with the given initial value.
+    explicit seqlock(const T &value)
+    {
+        write_words(value);
+    }
+
+    /// @brief Get a consistent copy of the protected value. Retries while a writer is active.
+    [[nodiscard]] T load() const
+    {
+        detail::spin_backoff backoff;
+        for (;;)
+        {
+            const u32 before = m_sequence.load(std::memory_order_acquire);
+            if ((before & 1U) == 0)
+            {
+                T value = read_words();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == before)
+                {
+                    return value;
+                }
+            }
+            backoff.pause();
+        }
+    }
+
+    /// @brief Replace the protected value.
+    void store(const T &value)
+    {
+        detail::spin_backoff backoff;
+        u32 sequence = m_sequence.load(std::memory_order_relaxed);
+        while ((sequence & 1U) != 0 ||
+               !m_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed))
+        {
+            backoff.pause();
+            sequence = m_sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        write_words(value);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+  private:
+    [[nodiscard]] T read_words() const
+    {
+        usz words[word_count];
+        for (usz i = 0; i < word_count; ++i)
+        {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    void write_words(const T &value)
+    {
+        usz words[word_count] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (usz i = 0; i < word_count; ++i)
+        {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<u32> m_sequence = 0;
+    std::atomic<usz> m_words[word_count];
+};
+
+///
+/// @}
+///
+
+} // namespace qz
@@ -0,0 +1,87 @@
+#include "quartz/clock.hpp"
+
+#if QZ_HAS_TSC && !defined(_MSC_VER)
+    #include <cpuid.h>
+#endif
+
+namespace /* anonymous namespace */
+{
+
+#if QZ_HAS_TSC
+bool has_invariant_tsc()
+{
+    // CPUID leaf 0x80000007, EDX bit 8: the time stamp counter runs at a constant rate in all power states.
+    unsigned int regs[4] = {};
+    #if defined(_MSC_VER)
+    __cpuid(reinterpret_cast<int *>(regs), static_cast<int>(0x80000000U)); // NOLINT
+    if (regs[0] < 0x80000007U)
+    {
+        return false;
+    }
+    __cpuid(reinterpret_cast<int *>(regs), static_cast<int>(0x80000007U)); // NOLINT
+    #else
+    if (__get_cpuid(0x80000007U, &regs[0], &regs[1], &regs[2], &regs[3]) == 0)
+    {
+        return false;
+    }
+    #endif
+    return (regs[3] & (1U << 8U)) != 0;
+}
+#endif
+
+qz::s64 steady_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+qz::detail::tsc_calibration calibrate()
+{
+    constexpr qz::detail::tsc_calibration fallback{
+        .uses_tsc    = false,
+        .ns_per_tick = 1.0,
+        .base_ticks  = 0,
+        .base_ns     = 0,
+    };
+
+#if QZ_HAS_TSC
+    if (!has_invariant_tsc())
+    {
+        return fallback;
+    }
+
+    // spin for ~10 ms and compare the elapsed ticks against the elapsed steady clock time.
+    constexpr qz::s64 calibration_ns = 10'000'000;
+
+    const auto start_ns    = steady_ns();
+    const auto start_ticks = __rdtsc();
+    auto end_ns            = start_ns;
+    while (end_ns - start_ns < calibration_ns)
+    {
+        end_ns = steady_ns();
+    }
+    const auto end_ticks = __rdtsc();
+
+    if (end_ticks <= start_ticks)
+    {
+        return fallback;
+    }
+
+    return {
+        .uses_tsc    = true,
+        .ns_per_tick = static_cast<qz::f64>(end_ns - start_ns) / static_cast<qz::f64>(end_ticks - start_ticks),
+        .base_ticks  = end_ticks,
+        .base_ns     = end_ns,
+    };
+#else
+    return fallback;
+#endif
+}
+
+} // namespace
+
+const qz::detail::tsc_calibration &qz::detail::get_tsc_calibration()
+{
+    static const tsc_calibration calibration = calibrate();
+    return calibration;
+}
@@ -0,0 +1,35 @@
+#include "quartz/coroutine.hpp"
+
+namespace /* anonymous namespace */
+{
+
+// the header in front of every frame, sized so that the frame itself keeps the default new alignment.
+constexpr qz::usz header_size = qz::frame_arena::alignment;
+
+} // namespace
+
+void *qz::detail::allocate_frame(frame_arena *arena, usz size)
+{
+    void *memory = arena != nullptr ? arena->allocate(size + header_size) : nullptr;
+    if (memory == nullptr)
+    {
+        memory = ::operator new(size + header_size);
+        arena  = nullptr;
+    }
+    *static_cast<frame_arena **>(memory) = arena;
+    return static_cast<std::byte *>(memory) + header_size;
+}
+
+void qz::detail::deallocate_frame(void *frame, usz size) noexcept
+{
+    auto *memory = static_cast<std::byte *>(frame) - header_size;
+    auto *arena  = *reinterpret_cast<frame_arena **>(memory);
+    if (arena != nullptr)
+    {
+        arena->deallocate(memory, size + header_size);
+    }
+    else
+    {
+        ::operator delete(memory, size + header_size);
+    }
+}
@@ -0,0 +1,150 @@
+#include "quartz/epoch.hpp"
+
+#include <mutex>
+#include <thread>
+
+qz::epoch::epoch(usz slot_count)
+    : m_slot_count(slot_count == 0 ? 1 : slot_count),
+      m_slots(std::make_unique<cache_padded<std::atomic<u64>>[]>(m_slot_count))
+{
+    m_retired.reserve(reclaim_threshold);
+}
+
+qz::epoch::~epoch()
+{
+    // deleters may retire further objects into this domain, which are freed in turn.
+    while (!m_retired.empty())
+    {
+        std::vector<retired> freeable;
+        freeable.swap(m_retired);
+        for (const auto &entry : freeable)
+        {
+            entry.deleter(entry.object);
+        }
+    }
+}
+
+qz::epoch &qz::epoch::global()
+{
+    static epoch domain;
+    return domain;
+}
+
+void qz::epoch::retire(void *object, void (*deleter)(void *))
+{
+    bool full = false;
+    {
+        std::lock_guard guard(m_lock);
+        // the epoch is read after the object was unlinked, so readers pinned at a later epoch cannot reach it.
+        m_retired.push_back({object, deleter, m_epoch.load(std::memory_order_seq_cst)});
+        full = m_retired.size() >= m_reclaim_at;
+    }
+    if (full)
+    {
+        reclaim();
+    }
+}
+
+qz::usz qz::epoch::reclaim()
+{
+    std::vector<retired> freeable;
+    {
+        std::lock_guard guard(m_lock);
+        if (m_retired.empty())
+        {
+            return 0;
+        }
+
+        // objects become unreachable two epochs after their retirement, so try advancing twice.
+        try_advance();
+        const u64 current = try_advance();
+
+        // objects are retired in epoch order, so the freeable ones form a prefix of the list.
+        usz count = 0;
+        while (count < m_retired.size() && m_retired[count].retired_at + 2 <= current)
+        {
+            ++count;
+        }
+        const auto end = m_retired.begin() + static_cast<ssz>(count);
+        freeable.assign(m_retired.begin(), end);
+        m_retired.erase(m_retired.begin(), end);
+
+        // while readers hold back the remaining objects, wait for another batch before trying again.
+        m_reclaim_at = m_retired.size() + reclaim_threshold;
+    }
+
+    // deleters run outside of the lock, as they may retire further objects.
+    for (const auto &entry : freeable)
+    {
+        entry.deleter(entry.object);
+    }
+    return freeable.size();
+}
+
+void qz::epoch::synchronize()
+{
+    u64 target = 0;
+    {
+        std::lock_guard guard(m_lock);
+        if (m_retired.empty())
+        {
+            return;
+        }
+        target = m_retired.back().retired_at + 2;
+    }
+
+    detail::spin_backoff backoff;
+    for (auto attempt = 0;; ++attempt)
+    {
+        reclaim();
+        {
+            std::lock_guard guard(m_lock);
+            if (m_retired.empty() || m_retired.front().retired_at + 2 > target)
+            {
+                return;
+            }
+        }
+        // the remaining readers may be descheduled, so stop spinning after a while.
+        if (attempt < 16)
+        {
+            backoff.pause();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+qz::usz qz::epoch::pending() const
+{
+    std::lock_guard guard(m_lock);
+    return m_retired.size();
+}
+
+qz::u64 qz::epoch::try_advance()
+{
+    const u64 current = m_epoch.load(std::memory_order_seq_cst);
+    const u64 tag     = current << count_bits;
+    for (usz i = 0; i < m_slot_count; ++i)
+    {
+        auto &slot = m_slots[i].value;
+        u64 state  = slot.load(std::memory_order_seq_cst);
+        if ((state & count_mask) == 0)
+        {
+            // a reader pinning in the meantime keeps the old epoch, which holds back the next advance instead.
+            if ((state >> count_bits) != (tag >> count_bits))
+            {
+                slot.compare_exchange_strong(state, tag, std::memory_order_seq_cst);
+            }
+        }
+        else if ((state >> count_bits) != (tag >> count_bits))
+        {
+            return current;
+        }
+    }
+
+    // only this function advances the epoch, under the lock.
+    m_epoch.store(current + 1, std::memory_order_seq_cst);
+    return current + 1;
+}
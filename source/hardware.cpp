@@ -0,0 +1,9 @@
+#include "quartz/hardware.hpp"
+
+#include <atomic>
+
+qz::u32 qz::detail::allocate_thread_index()
+{
+    static std::atomic<u32> next_index = 0;
+    return next_index.fetch_add(1, std::memory_order_relaxed);
+}
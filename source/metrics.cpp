@@ -0,0 +1,251 @@
+#include "quartz/metrics.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+#include "quartz/assert.hpp"
+#include "quartz/format.hpp"
+
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace /* anonymous namespace */
+{
+
+// appends to a caller provided buffer, remembering whether anything did not fit.
+class buffer_sink
+{
+  public:
+    buffer_sink(char *first, char *last) : m_next(first), m_last(last)
+    {
+    }
+
+    void append(std::string_view text)
+    {
+        if (m_next == nullptr || static_cast<qz::usz>(m_last - m_next) < text.size())
+        {
+            m_next = nullptr;
+            return;
+        }
+        std::memcpy(m_next, text.data(), text.size());
+        m_next += text.size();
+    }
+
+    [[nodiscard]] char *finish() const
+    {
+        return m_next;
+    }
+
+  private:
+    char *m_next;
+    char *m_last;
+};
+
+// collects the output in a buffer on the stack, which is written to the file descriptor whenever it fills up.
+class fd_sink
+{
+  public:
+    explicit fd_sink(int fd) : m_fd(fd)
+    {
+    }
+
+    void append(std::string_view text)
+    {
+        while (!text.empty())
+        {
+            const auto count = std::min(text.size(), sizeof(m_buffer) - m_size);
+            std::memcpy(m_buffer + m_size, text.data(), count);
+            m_size += count;
+            text.remove_prefix(count);
+            if (m_size == sizeof(m_buffer))
+            {
+                flush();
+            }
+        }
+    }
+
+    [[nodiscard]] bool finish()
+    {
+        flush();
+        return m_ok;
+    }
+
+  private:
+    void flush()
+    {
+        // writes to pipes and sockets may be partial, or interrupted by signals.
+        const char *next = m_buffer;
+        while (m_ok && next != m_buffer + m_size)
+        {
+            const auto remaining = static_cast<qz::usz>(m_buffer + m_size - next);
+            const auto written   = write_some(next, remaining);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            m_ok = written > 0;
+            next += m_ok ? written : 0;
+        }
+        m_size = 0;
+    }
+
+    // a scraper closing its connection early must not raise SIGPIPE, so sockets are written with MSG_NOSIGNAL where
+    // the platform has it. Anything else falls back to write() once send() reports that it is not a socket.
+    qz::ssz write_some(const char *data, qz::usz size)
+    {
+#if defined(_WIN32)
+        return ::_write(m_fd, data, static_cast<unsigned int>(size));
+#else
+    #if defined(MSG_NOSIGNAL)
+        if (m_is_socket)
+        {
+            const auto sent = ::send(m_fd, data, size, MSG_NOSIGNAL);
+            if (sent >= 0 || errno != ENOTSOCK)
+            {
+                return sent;
+            }
+            m_is_socket = false;
+        }
+    #endif
+        return ::write(m_fd, data, size);
+#endif
+    }
+
+    char m_buffer[4096];
+    qz::usz m_size = 0;
+    int m_fd;
+    bool m_ok        = true;
+    bool m_is_socket = true;
+};
+
+// help texts escape backslashes and line feeds.
+template <class Sink>
+void append_help(Sink &sink, std::string_view help)
+{
+    for (auto special = help.find_first_of("\\\n"); special != std::string_view::npos;
+         special      = help.find_first_of("\\\n"))
+    {
+        sink.append(help.substr(0, special));
+        sink.append(help[special] == '\\' ? "\\\\" : "\\n");
+        help.remove_prefix(special + 1);
+    }
+    sink.append(help);
+}
+
+template <class Sink, class T>
+void append_number(Sink &sink, T value)
+{
+    char buffer[qz::max_formatted_size<T>];
+    const auto *end = qz::format_to(buffer, buffer + sizeof(buffer), value);
+    sink.append({buffer, static_cast<qz::usz>(end - buffer)});
+}
+
+} // namespace
+
+qz::metric_registry::~metric_registry()
+{
+    for (auto &metric : m_metrics)
+    {
+        metric.m_registry = nullptr;
+    }
+}
+
+qz::metric_registry &qz::metric_registry::global()
+{
+    static metric_registry registry;
+    return registry;
+}
+
+void qz::metric_registry::add(metric &metric)
+{
+    QZ_VERIFY_MSG(is_valid_name(metric.name()), "Metric names must match [a-zA-Z_:][a-zA-Z0-9_:]*.");
+    QZ_VERIFY_MSG(metric.m_registry == nullptr, "The metric is already in a registry.");
+
+    std::lock_guard guard(m_lock);
+    auto position = m_metrics.begin();
+    while (position != m_metrics.end() && position->name() < metric.name())
+    {
+        ++position;
+    }
+    QZ_VERIFY_MSG(position == m_metrics.end() || position->name() != metric.name(),
+                  "A metric with the same name is already in the registry.");
+    m_metrics.insert(position, metric);
+    metric.m_registry = this;
+}
+
+void qz::metric_registry::remove(metric &metric)
+{
+    std::lock_guard guard(m_lock);
+    if (metric.m_registry == this)
+    {
+        m_metrics.erase(metric);
+        metric.m_registry = nullptr;
+    }
+}
+
+qz::usz qz::metric_registry::size() const
+{
+    std::lock_guard guard(m_lock);
+    return m_metrics.size();
+}
+
+template <class Sink>
+void qz::metric_registry::write_to(Sink &sink) const
+{
+    std::lock_guard guard(m_lock);
+    for (const auto &metric : m_metrics)
+    {
+        const bool is_counter = metric.type() == metric_type::counter;
+        if (!metric.help().empty())
+        {
+            sink.append("# HELP ");
+            sink.append(metric.name());
+            sink.append(" ");
+            append_help(sink, metric.help());
+            sink.append("\n");
+        }
+        sink.append("# TYPE ");
+        sink.append(metric.name());
+        sink.append(is_counter ? " counter\n" : " gauge\n");
+        sink.append(metric.name());
+        sink.append(" ");
+        if (is_counter)
+        {
+            append_number(sink, metric.sum_bits());
+        }
+        else
+        {
+            append_number(sink, static_cast<s64>(metric.sum_bits()));
+        }
+        sink.append("\n");
+    }
+}
+
+char *qz::metric_registry::write(char *first, char *last) const
+{
+    buffer_sink sink(first, last);
+    write_to(sink);
+    return sink.finish();
+}
+
+bool qz::metric_registry::write(int fd) const
+{
+    fd_sink sink(fd);
+    write_to(sink);
+    return sink.finish();
+}
+
+bool qz::metric_registry::is_valid_name(std::string_view name)
+{
+    const auto is_start = [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+    };
+    return !name.empty() && is_start(name.front()) &&
+           std::all_of(name.begin() + 1, name.end(), [&](char c) { return is_start(c) || (c >= '0' && c <= '9'); });
+}
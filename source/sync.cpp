@@ -0,0 +1,53 @@
+#include "quartz/sync.hpp"
+
+#if defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+void qz::detail::futex_wait(std::atomic<u32> &word, u32 expected)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32 *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0); // NOLINT
+#elif defined(_WIN32)
+    WaitOnAddress(&word, &expected, sizeof(expected), INFINITE);
+#else
+    word.wait(expected, std::memory_order_relaxed);
+#endif
+}
+
+void qz::detail::futex_wake_one(std::atomic<u32> &word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32 *>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0); // NOLINT
+#elif defined(_WIN32)
+    WakeByAddressSingle(&word);
+#else
+    word.notify_one();
+#endif
+}
+
+void qz::mutex::lock_contended()
+{
+    // spin for a short while first, the owner is likely to release the lock soon.
+    for (auto i = 0; i < 64; ++i)
+    {
+        cpu_pause();
+        u32 state = m_state.load(std::memory_order_relaxed);
+        if (state == unlocked &&
+            m_state.compare_exchange_weak(state, locked, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    // mark the lock as contended so that the owner wakes us up when unlocking, then sleep.
+    while (m_state.exchange(locked_contended, std::memory_order_acquire) != unlocked)
+    {
+        detail::futex_wait(m_state, locked_contended);
+    }
+}
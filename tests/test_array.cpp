@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <quartz/array.hpp>
-#include <quartz/memory.hpp>
+#include <quartz/utilities.hpp>
+#include <stdexcept>
 #include <utility>
 
 namespace
@@ -148,3 +149,28 @@ TEST(QzArray, Fill_Swap)
 
     EXPECT_EQ(match_count, array_a.size()); // all values matched.
 }
+
+TEST(QzArray, Checked_Access)
+{
+    qz::array array{1, 2, 3};
+    EXPECT_EQ(array.at(2), 3);
+#if defined(QZ_NO_EXCEPTIONS)
+    EXPECT_DEATH(static_cast<void>(array.at(3)), "");
+#else
+    EXPECT_THROW(static_cast<void>(array.at(3)), std::out_of_range);
+#endif
+
+    auto element = array.try_at(1);
+    ASSERT_TRUE(element.has_value());
+    *element = 5;
+    EXPECT_EQ(array[1], 5);
+    EXPECT_FALSE(array.try_at(3).has_value());
+
+    constexpr qz::array const_array{1, 2, 3};
+    static_assert(const_array.try_at(0).value() == 1, "Expected in bounds access to succeed.");
+    static_assert(!const_array.try_at(3), "Expected out of bounds access to fail.");
+
+    constexpr qz::array<int, 0> empty_array{};
+    static_assert(!empty_array.try_at(0), "Expected empty array access to fail.");
+}
+
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include <quartz/btree.hpp>
+#include <quartz/random.hpp>
+
+#include <cmath>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+TEST(QzBTree, Insert_Find)
+{
+    qz::btree_map<int, std::string> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+
+    EXPECT_TRUE(map.insert({2, "two"}).second);
+    EXPECT_TRUE(map.try_emplace(1, 3, 'a').second);
+    EXPECT_FALSE(map.try_emplace(1, "ignored").second);
+    map[3] = "three";
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(1), "aaa");
+    EXPECT_EQ(map.find(2)->second, "two");
+    EXPECT_TRUE(map.contains(3));
+    EXPECT_EQ(map.count(4), 0);
+    EXPECT_FALSE(map.try_at(4).has_value());
+
+    EXPECT_FALSE(map.insert_or_assign(2, "deux").second);
+    EXPECT_EQ(map.try_at(2).value(), "deux");
+#if defined(QZ_NO_EXCEPTIONS)
+    EXPECT_DEATH(static_cast<void>(map.at(4)), "");
+#else
+    EXPECT_THROW(static_cast<void>(map.at(4)), std::out_of_range);
+#endif
+}
+
+TEST(QzBTree, Ordered_Iteration)
+{
+    qz::btree_set<qz::u32> set;
+    qz::xoshiro256pp engine(7);
+    std::set<qz::u32> expected;
+    for (auto i = 0; i < 5000; ++i)
+    {
+        const auto key = static_cast<qz::u32>(qz::uniform_int(engine, 100000));
+        EXPECT_EQ(set.insert(key).second, expected.insert(key).second);
+    }
+    EXPECT_EQ(set.size(), expected.size());
+    EXPECT_GT(set.height(), 1);
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+
+    // walking backwards from the end visits the leaves through their back links.
+    auto it = set.end();
+    for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit)
+    {
+        EXPECT_EQ(*--it, *rit);
+    }
+    EXPECT_EQ(it, set.begin());
+
+    for (const qz::u32 key : {0U, 500U, 99999U, 100000U})
+    {
+        const auto lower = expected.lower_bound(key);
+        const auto upper = expected.upper_bound(key);
+        EXPECT_EQ(set.lower_bound(key) == set.end() ? expected.end() : expected.find(*set.lower_bound(key)), lower);
+        EXPECT_EQ(set.upper_bound(key) == set.end() ? expected.end() : expected.find(*set.upper_bound(key)), upper);
+    }
+}
+
+TEST(QzBTree, Erase_Rebalance)
+{
+    qz::btree_map<qz::u64, qz::u64> map;
+    std::map<qz::u64, qz::u64> expected;
+    qz::xoshiro256pp engine(42);
+
+    // alternate phases of mostly inserting and mostly erasing, so that nodes both split and merge at every level.
+    for (auto phase = 0; phase < 6; ++phase)
+    {
+        for (auto i = 0; i < 20000; ++i)
+        {
+            const auto key = qz::uniform_int(engine, 30000);
+            if (qz::uniform_int(engine, 4) < (phase % 2 == 0 ? 3U : 1U))
+            {
+                map[key] = key * 2;
+                expected[key] = key * 2;
+            }
+            else
+            {
+                EXPECT_EQ(map.erase(key), expected.erase(key));
+            }
+        }
+        ASSERT_EQ(map.size(), expected.size());
+        auto it = map.begin();
+        for (const auto &[key, value] : expected)
+        {
+            ASSERT_EQ(it.key(), key);
+            ASSERT_EQ(it->second, value);
+            ++it;
+        }
+        EXPECT_EQ(it, map.end());
+    }
+
+    // erasing through an iterator returns the position of the next element.
+    const auto key = expected.begin()->first;
+    auto next      = map.erase(map.find(key));
+    EXPECT_EQ(next.key(), std::next(expected.begin())->first);
+
+    while (!map.empty())
+    {
+        map.erase(map.begin());
+    }
+    EXPECT_EQ(map.height(), 0);
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(QzBTree, Bulk_Load)
+{
+    std::vector<qz::u64> keys;
+    for (qz::u64 i = 0; i < 100000; ++i)
+    {
+        keys.push_back(i * 3);
+        if (i % 10 == 0)
+        {
+            keys.push_back(i * 3); // duplicates are skipped.
+        }
+    }
+
+    qz::btree_set<qz::u64> set;
+    set.bulk_load(keys.begin(), keys.end());
+    EXPECT_EQ(set.size(), 100000);
+    EXPECT_TRUE(set.contains(2997) && !set.contains(2998));
+    EXPECT_EQ(*set.lower_bound(2998), 3000);
+
+    // full leaves and inner nodes give the minimal height.
+    const auto fanout = qz::btree_set<qz::u64>::node_capacity;
+    const auto levels = std::ceil(std::log(100000.0 / fanout) / std::log(fanout + 1.0));
+    EXPECT_LE(set.height(), 1 + static_cast<qz::usz>(levels));
+
+    // a bulk loaded tree keeps working with regular inserts and erasures.
+    for (qz::u64 i = 0; i < 300000; i += 2)
+    {
+        set.erase(i);
+    }
+    set.insert(1);
+    EXPECT_EQ(set.size(), 50001);
+    EXPECT_EQ(*set.begin(), 1);
+    EXPECT_EQ(*++set.begin(), 3);
+
+    // copies are bulk loaded from the source.
+    qz::btree_map<int, int> map{{1, 10}, {2, 20}, {3, 30}};
+    auto copy  = map;
+    auto moved = qz::move(map);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(copy.at(2), 20);
+    EXPECT_EQ(moved.at(3), 30);
+}
+
+TEST(QzBTree, Custom_Compare)
+{
+    // string keys and a custom ordering go through the branch free binary search.
+    qz::btree_map<std::string, int, std::greater<>> map;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        map[std::to_string(i)] = i;
+    }
+    EXPECT_EQ(map.begin().key(), "999");
+    EXPECT_EQ(map.at("500"), 500);
+    EXPECT_EQ(map.lower_bound("5").key(), "5");
+    EXPECT_EQ(map.upper_bound("5").key(), "499");
+
+    for (auto i = 0; i < 1000; i += 2)
+    {
+        EXPECT_EQ(map.erase(std::to_string(i)), 1);
+    }
+    EXPECT_EQ(map.size(), 500);
+    EXPECT_FALSE(map.contains("0"));
+    EXPECT_EQ(map.at("1"), 1);
+}
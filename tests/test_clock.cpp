@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <quartz/clock.hpp>
+
+#include <thread>
+
+static_assert(std::chrono::is_clock_v<qz::tsc_clock>);
+
+TEST(QzClock, Monotonic)
+{
+    qz::tsc_clock::calibrate();
+
+    auto previous = qz::tsc_clock::now();
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto current = qz::tsc_clock::now();
+        EXPECT_GE(current, previous);
+        previous = current;
+    }
+
+    const auto ticks_a = qz::tsc_clock::ticks();
+    const auto ticks_b = qz::tsc_clock::ticks_ordered();
+    EXPECT_GE(ticks_b, ticks_a);
+}
+
+TEST(QzClock, Calibration)
+{
+    // the clock agrees with the steady clock over a sleep, give or take scheduling noise.
+    const auto steady_start = std::chrono::steady_clock::now();
+    const auto tsc_start    = qz::tsc_clock::now();
+    const auto ticks_start  = qz::tsc_clock::ticks();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const auto ticks_elapsed = qz::tsc_clock::to_duration(qz::tsc_clock::ticks() - ticks_start);
+    const auto tsc_elapsed   = qz::tsc_clock::now() - tsc_start;
+    const auto steady_elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - steady_start);
+
+    EXPECT_NEAR(static_cast<double>(tsc_elapsed.count()), static_cast<double>(steady_elapsed.count()), 5e6);
+    EXPECT_NEAR(static_cast<double>(ticks_elapsed.count()), static_cast<double>(steady_elapsed.count()), 5e6);
+}
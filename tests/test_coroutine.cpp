@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <quartz/coroutine.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+qz::generator<int> iota(int count)
+{
+    for (auto i = 0; i < count; ++i)
+    {
+        co_yield i;
+    }
+}
+
+qz::generator<int &> elements(std::vector<int> &values)
+{
+    for (auto &value : values)
+    {
+        co_yield value;
+    }
+}
+
+// yields the values of a complete binary tree of the given depth in order, one nested generator per node.
+qz::generator<int> in_order(int depth, int offset)
+{
+    if (depth == 0)
+    {
+        co_return;
+    }
+    const auto half = (1 << (depth - 1)) - 1;
+    co_yield qz::elements_of(in_order(depth - 1, offset));
+    co_yield offset + half;
+    co_yield qz::elements_of(in_order(depth - 1, offset + half + 1));
+}
+
+qz::generator<std::string> words(qz::frame_arena & /* unused */, int count)
+{
+    for (auto i = 0; i < count; ++i)
+    {
+        co_yield std::to_string(i);
+    }
+}
+
+qz::task<int> add(int a, int b)
+{
+    co_return a + b;
+}
+
+qz::task<int> sum_to(int n)
+{
+    if (n == 0)
+    {
+        co_return 0;
+    }
+    const auto rest = co_await sum_to(n - 1);
+    co_return n + rest;
+}
+
+qz::task<> append(std::vector<int> &values, int value)
+{
+    values.push_back(co_await add(value, 0));
+}
+
+} // namespace
+
+TEST(QzCoroutine, Generator_Values)
+{
+    auto sum = 0;
+    for (const auto value : iota(10))
+    {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 45);
+
+    // reference generators expose the values in place.
+    std::vector<int> values = {1, 2, 3};
+    for (auto &value : elements(values))
+    {
+        value *= 10;
+    }
+    EXPECT_EQ(values, (std::vector<int>{10, 20, 30}));
+
+    auto empty = iota(0);
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(QzCoroutine, Generator_Nested)
+{
+    std::vector<int> values;
+    for (const auto value : in_order(10, 0))
+    {
+        values.push_back(value);
+    }
+    ASSERT_EQ(values.size(), 1023);
+    for (auto i = 0; i < 1023; ++i)
+    {
+        EXPECT_EQ(values[i], i);
+    }
+
+#if !defined(QZ_NO_EXCEPTIONS)
+    // exceptions propagate out of nested generators to the consumer.
+    auto throwing = []() -> qz::generator<int> {
+        co_yield 1;
+        throw std::runtime_error("nested");
+    };
+    auto outer = [&]() -> qz::generator<int> { co_yield qz::elements_of(throwing()); };
+    auto generator = outer();
+    auto it        = generator.begin();
+    EXPECT_EQ(*it, 1);
+    EXPECT_THROW(++it, std::runtime_error);
+#endif
+}
+
+TEST(QzCoroutine, Frame_Arena)
+{
+    alignas(qz::frame_arena::alignment) std::byte buffer[1024];
+    qz::frame_arena arena(buffer);
+    {
+        auto generator = words(arena, 3);
+        EXPECT_GT(arena.used(), 0);
+        std::string joined;
+        for (const auto &word : generator)
+        {
+            joined += word;
+        }
+        EXPECT_EQ(joined, "012");
+    }
+    EXPECT_EQ(arena.used(), 0);
+
+    // lambdas take the arena after their object, followed by any other parameters.
+    const std::string prefix = "x";
+    auto prefixed = [](qz::frame_arena & /* unused */, const std::string &text, int count) -> qz::generator<int> {
+        for (auto i = 0; i < count; ++i)
+        {
+            co_yield static_cast<int>(text.size()) + i;
+        }
+    };
+    {
+        auto generator = prefixed(arena, prefix, 2);
+        EXPECT_GT(arena.used(), 0);
+        EXPECT_EQ(*generator.begin(), 1);
+    }
+    EXPECT_EQ(arena.used(), 0);
+
+    // frames which do not fit go to the heap, and the arena keeps working afterwards.
+    std::byte small_buffer[32];
+    qz::frame_arena small_arena(small_buffer);
+    {
+        auto generator = words(small_arena, 2);
+        EXPECT_EQ(small_arena.used(), 0);
+        EXPECT_EQ(*generator.begin(), "0");
+    }
+    EXPECT_EQ(small_arena.used(), 0);
+}
+
+TEST(QzCoroutine, Task_Chain)
+{
+    EXPECT_EQ(qz::sync_wait(add(2, 3)), 5);
+
+    EXPECT_EQ(qz::sync_wait(sum_to(1000)), 500500);
+
+    std::vector<int> values;
+    qz::sync_wait(append(values, 7));
+    EXPECT_EQ(values, std::vector<int>{7});
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <quartz/delta_array.hpp>
+#include <quartz/random.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+template <class T>
+void expect_round_trip(const std::vector<T> &values)
+{
+    const qz::delta_array<T> array(values);
+    ASSERT_EQ(array.size(), values.size());
+
+    std::vector<T> decoded(values.size());
+    EXPECT_EQ(array.decode(0, decoded), values.size());
+    EXPECT_EQ(decoded, values);
+
+    for (qz::usz i = 0; i < values.size(); i += 7)
+    {
+        EXPECT_EQ(array.get(i), values[i]) << i;
+    }
+}
+
+} // namespace
+
+TEST(QzDeltaArray, Monotonic_Timestamps)
+{
+    // nanosecond timestamps at a steady rate with some jitter.
+    qz::xoshiro256pp engine(7);
+    std::vector<qz::u64> timestamps;
+    qz::u64 time = 1'700'000'000'000'000'000ULL;
+    for (auto i = 0; i < 10'000; ++i)
+    {
+        time += 1000 + qz::uniform_int(engine, 64);
+        timestamps.push_back(time);
+    }
+    expect_round_trip(timestamps);
+
+    // rows advance by ~4000 with a spread of 256, so offsets take 8 bits plus the per block headers.
+    const qz::delta_array<qz::u64> array(timestamps);
+    EXPECT_LT(array.size_bytes(), timestamps.size() * 2);
+}
+
+TEST(QzDeltaArray, Random_And_Extreme_Values)
+{
+    qz::xoshiro256pp engine(11);
+    std::vector<qz::s64> values(1000);
+    for (auto &value : values)
+    {
+        value = static_cast<qz::s64>(engine());
+    }
+    values[5]   = std::numeric_limits<qz::s64>::min();
+    values[6]   = std::numeric_limits<qz::s64>::max();
+    values[200] = 0;
+    expect_round_trip(values);
+
+    std::vector<qz::u32> small(777);
+    for (auto &value : small)
+    {
+        value = static_cast<qz::u32>(qz::uniform_int(engine, 100));
+    }
+    expect_round_trip(small);
+
+    std::vector<qz::s16> negative(300);
+    for (qz::usz i = 0; i < negative.size(); ++i)
+    {
+        negative[i] = static_cast<qz::s16>(-static_cast<int>(i) * 3);
+    }
+    expect_round_trip(negative);
+}
+
+TEST(QzDeltaArray, Constant_Values)
+{
+    // a column of equal values needs no packed bits at all.
+    std::vector<qz::u32> values(1024, 42);
+    const qz::delta_array<qz::u32> array(values);
+    EXPECT_EQ(array.block_count(), 8);
+    EXPECT_LT(array.size_bytes(), 8 * 32);
+    expect_round_trip(values);
+}
+
+TEST(QzDeltaArray, Streaming)
+{
+    qz::delta_array<qz::u32> array;
+    for (qz::u32 i = 0; i < 1000; ++i)
+    {
+        array.push_back(i * i);
+    }
+    EXPECT_EQ(array.size(), 1000);
+    EXPECT_EQ(array.block_count(), 7);
+
+    // chunks which neither start nor end at block boundaries, running into the uncompressed tail.
+    qz::u32 chunk[100];
+    qz::usz position = 0;
+    while (const auto count = array.decode(position, chunk))
+    {
+        for (qz::usz i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(chunk[i], (position + i) * (position + i));
+        }
+        position += count;
+    }
+    EXPECT_EQ(position, 1000);
+
+    array.clear();
+    EXPECT_TRUE(array.empty());
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <quartz/epoch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct tracked
+{
+    explicit tracked(std::atomic<int> &live) : live(&live)
+    {
+        live.fetch_add(1);
+    }
+
+    ~tracked()
+    {
+        live->fetch_sub(1);
+    }
+
+    std::atomic<int> *live;
+};
+
+// readers check that the fields are consistent, and that the object has not been destroyed under them.
+struct config
+{
+    static constexpr qz::u64 alive_tag = 0xA11CE;
+
+    explicit config(qz::u64 version) : version(version), doubled(version * 2)
+    {
+    }
+
+    config(const config &) = default;
+
+    ~config()
+    {
+        tag = 0;
+    }
+
+    qz::u64 version;
+    qz::u64 doubled;
+    qz::u64 tag = alive_tag;
+};
+
+} // namespace
+
+TEST(QzEpoch, Pin_Retire)
+{
+    qz::epoch domain(4);
+    std::atomic<int> live = 0;
+
+    {
+        auto guard = domain.pin();
+        auto inner = domain.pin(); // guards nest.
+        domain.retire(new tracked(live));
+        EXPECT_EQ(domain.reclaim(), 0);
+        EXPECT_EQ(live, 1);
+    }
+
+    // unpinned, so two advances make the object unreachable.
+    EXPECT_EQ(domain.reclaim(), 1);
+    EXPECT_EQ(live, 0);
+    EXPECT_EQ(domain.pending(), 0);
+
+    // retiring a full batch frees the objects without an explicit reclaim.
+    for (qz::usz i = 0; i < qz::epoch::reclaim_threshold; ++i)
+    {
+        domain.retire(new tracked(live));
+    }
+    EXPECT_EQ(live, 0);
+
+    // a reader pinned on another thread holds back objects retired after it pinned.
+    std::atomic<bool> pinned  = false;
+    std::atomic<bool> release = false;
+    std::thread reader([&] {
+        auto guard = domain.pin();
+        pinned     = true;
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned)
+    {
+        std::this_thread::yield();
+    }
+    domain.retire(new tracked(live));
+    domain.reclaim();
+    domain.reclaim();
+    EXPECT_EQ(live, 1);
+
+    release = true;
+    reader.join();
+    domain.synchronize();
+    EXPECT_EQ(live, 0);
+
+    // the domain frees what remains when it is destroyed.
+    {
+        qz::epoch scoped;
+        auto guard = scoped.pin();
+        scoped.retire(new tracked(live));
+        EXPECT_EQ(live, 1);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(QzEpoch, Rcu_Ptr)
+{
+    qz::epoch domain;
+    qz::rcu_ptr<config> ptr(std::make_unique<config>(1), domain);
+
+    auto first = ptr.read();
+    EXPECT_EQ(first->version, 1);
+
+    ptr.emplace(2);
+    ptr.update([](config &value) {
+        value.version += 10;
+        value.doubled = value.version * 2;
+    });
+
+    // the first reader still sees the object it pinned, which has not been freed.
+    EXPECT_EQ(first->version, 1);
+    EXPECT_EQ(first->tag, config::alive_tag);
+    EXPECT_EQ(ptr.read()->version, 12);
+
+    {
+        auto guard = domain.pin();
+        EXPECT_EQ(ptr.load(guard)->doubled, 24);
+    }
+
+    qz::rcu_ptr<config> empty(domain);
+    EXPECT_FALSE(empty.read());
+    EXPECT_EQ(empty.read().get(), nullptr);
+}
+
+TEST(QzEpoch, Stress)
+{
+    constexpr auto reader_count = 4;
+    constexpr auto write_count  = 20000;
+
+    qz::epoch domain(8);
+    std::atomic<bool> done = false;
+    std::atomic<int> inconsistent_reads = 0;
+
+    {
+        qz::rcu_ptr<config> ptr(std::make_unique<config>(0), domain);
+
+        std::vector<std::thread> readers;
+        for (auto i = 0; i < reader_count; ++i)
+        {
+            readers.emplace_back([&] {
+                qz::u64 last_version = 0;
+                while (!done)
+                {
+                    const auto value = ptr.read();
+                    // versions only move forward, and an object is never freed while it is being read.
+                    if (value->tag != config::alive_tag || value->doubled != value->version * 2 ||
+                        value->version < last_version)
+                    {
+                        inconsistent_reads.fetch_add(1);
+                    }
+                    last_version = value->version;
+                }
+            });
+        }
+
+        // two writers racing, so that some of the updates are retried on a newer object.
+        std::thread updater([&] {
+            for (auto i = 0; i < write_count; ++i)
+            {
+                ptr.update([](config &value) {
+                    value.version += 1;
+                    value.doubled = value.version * 2;
+                });
+            }
+        });
+        for (auto i = 0; i < write_count; ++i)
+        {
+            ptr.update([](config &value) {
+                value.version += 1;
+                value.doubled = value.version * 2;
+            });
+        }
+        updater.join();
+        done = true;
+        for (auto &reader : readers)
+        {
+            reader.join();
+        }
+
+        EXPECT_EQ(ptr.read()->version, 2 * write_count);
+
+        // retired objects are freed in batches as the writers go. How many depends on how long readers stay pinned,
+        // which is a whole time slice when a reader is preempted.
+        EXPECT_LT(domain.pending(), 2 * write_count);
+        domain.synchronize();
+        EXPECT_EQ(domain.pending(), 0);
+    }
+
+    EXPECT_EQ(inconsistent_reads, 0);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <quartz/expected.hpp>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+enum class parse_error
+{
+    empty,
+    invalid_digit,
+};
+
+qz::expected<int, parse_error> parse_digit(const char *text)
+{
+    if (text[0] == '\0')
+    {
+        return qz::unexpected(parse_error::empty);
+    }
+    if (text[0] < '0' || text[0] > '9')
+    {
+        return qz::unexpected(parse_error::invalid_digit);
+    }
+    return text[0] - '0';
+}
+
+// counts live instances, and throws from its copy constructor while copies are disallowed.
+struct throwing_copy
+{
+    static inline int live        = 0;
+    static inline bool copy_fails = false;
+
+    explicit throwing_copy(int value) : value(value)
+    {
+        ++live;
+    }
+
+    throwing_copy(const throwing_copy &other) : value(other.value)
+    {
+        if (copy_fails)
+        {
+            QZ_THROW(std::runtime_error, "copy failed");
+        }
+        ++live;
+    }
+
+    throwing_copy(throwing_copy &&other) noexcept : value(other.value)
+    {
+        ++live;
+    }
+
+    throwing_copy &operator=(const throwing_copy &other)
+    {
+        if (copy_fails)
+        {
+            QZ_THROW(std::runtime_error, "copy failed");
+        }
+        value = other.value;
+        return *this;
+    }
+
+    throwing_copy &operator=(throwing_copy &&other) noexcept = default;
+
+    ~throwing_copy()
+    {
+        --live;
+    }
+
+    int value;
+};
+
+} // namespace
+
+//
+
+static_assert(std::is_trivially_copyable_v<qz::expected<int, parse_error>>);
+static_assert(std::is_trivially_destructible_v<qz::expected<int, parse_error>>);
+static_assert(std::is_trivially_copyable_v<qz::expected<void, parse_error>>);
+static_assert(!std::is_trivially_destructible_v<qz::expected<std::string, parse_error>>);
+static_assert(!std::is_copy_constructible_v<qz::expected<std::unique_ptr<int>, parse_error>>);
+static_assert(!std::is_copy_assignable_v<qz::expected<std::unique_ptr<int>, parse_error>>);
+static_assert(std::is_move_constructible_v<qz::expected<std::unique_ptr<int>, parse_error>>);
+static_assert(!std::is_move_constructible_v<qz::expected<int, std::mutex>>);
+static_assert(!std::is_move_assignable_v<qz::expected<int, std::mutex>>);
+
+TEST(QzExpected, Values_Errors)
+{
+    auto digit = parse_digit("7");
+    ASSERT_TRUE(digit.has_value());
+    EXPECT_EQ(*digit, 7);
+    EXPECT_EQ(digit.value(), 7);
+
+    auto failure = parse_digit("x");
+    ASSERT_FALSE(failure);
+    EXPECT_EQ(failure.error(), parse_error::invalid_digit);
+    EXPECT_EQ(failure.value_or(-1), -1);
+    EXPECT_DEATH(static_cast<void>(failure.value()), "");
+
+    EXPECT_EQ(parse_digit("").error(), parse_error::empty);
+}
+
+TEST(QzExpected, Non_Trivial_Types)
+{
+    qz::expected<std::string, std::string> value = std::string("value");
+    qz::expected<std::string, std::string> error = qz::unexpected(std::string("error"));
+
+    auto copy = value;
+    EXPECT_EQ(*copy, "value");
+
+    copy = error;
+    ASSERT_FALSE(copy.has_value());
+    EXPECT_EQ(copy.error(), "error");
+
+    copy = qz::move(value);
+    EXPECT_EQ(copy.value(), "value");
+}
+
+TEST(QzExpected, Chaining)
+{
+    auto doubled = parse_digit("4").transform([](int value) { return value * 2; });
+    EXPECT_EQ(doubled.value(), 8);
+
+    auto chained = parse_digit("4").and_then([](int value) { return parse_digit(value > 3 ? "z" : "1"); });
+    EXPECT_EQ(chained.error(), parse_error::invalid_digit);
+
+    qz::expected<void, parse_error> success;
+    EXPECT_TRUE(success.has_value());
+    success.value();
+
+    qz::expected<void, parse_error> failure = qz::unexpected(parse_error::empty);
+    EXPECT_EQ(failure.error(), parse_error::empty);
+}
+
+#if !defined(QZ_NO_EXCEPTIONS)
+TEST(QzExpected, Throwing_Copy)
+{
+    {
+        qz::expected<throwing_copy, std::string> value(throwing_copy(1));
+        const qz::expected<throwing_copy, std::string> other(throwing_copy(2));
+        qz::expected<throwing_copy, std::string> error = qz::unexpected(std::string("error"));
+
+        // a failed copy leaves the previous member in place, rather than nothing at all.
+        throwing_copy::copy_fails = true;
+        EXPECT_THROW(value = other, std::runtime_error);
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(value->value, 1);
+
+        EXPECT_THROW(error = other, std::runtime_error);
+        ASSERT_FALSE(error.has_value());
+        EXPECT_EQ(error.error(), "error");
+
+        throwing_copy::copy_fails = false;
+        error = other;
+        EXPECT_EQ(error->value, 2);
+        value = qz::expected<throwing_copy, std::string>(qz::unexpected(std::string("replaced")));
+        EXPECT_EQ(value.error(), "replaced");
+    }
+    EXPECT_EQ(throwing_copy::live, 0);
+}
+#endif
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <quartz/format.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+namespace
+{
+
+template <class T>
+std::string format(T value)
+{
+    char buffer[qz::max_formatted_size<T>];
+    auto *end = qz::format_to(buffer, buffer + sizeof(buffer), value);
+    return end == nullptr ? "<overflow>" : std::string(buffer, end);
+}
+
+} // namespace
+
+TEST(QzFormat, Integers)
+{
+    EXPECT_EQ(format(0), "0");
+    EXPECT_EQ(format(7U), "7");
+    EXPECT_EQ(format(-42), "-42");
+    EXPECT_EQ(format(std::numeric_limits<qz::s64>::min()), "-9223372036854775808");
+    EXPECT_EQ(format(std::numeric_limits<qz::u64>::max()), "18446744073709551615");
+    EXPECT_EQ(format(static_cast<qz::s8>(-128)), "-128");
+
+    // every digit count boundary.
+    qz::u64 power = 1;
+    for (auto i = 0; i < 20; ++i, power *= 10)
+    {
+        EXPECT_EQ(format(power), std::to_string(power));
+        EXPECT_EQ(format(power - 1), std::to_string(power - 1));
+    }
+
+    constexpr auto formatted = [] {
+        char buffer[4] = {};
+        qz::format_to(buffer, buffer + 4, -123);
+        return buffer[3];
+    }();
+    static_assert(formatted == '3');
+}
+
+TEST(QzFormat, Floats)
+{
+    EXPECT_EQ(format(0.0), "0");
+    EXPECT_EQ(format(0.1), "0.1");
+    EXPECT_EQ(format(-1.5f), "-1.5");
+    EXPECT_EQ(format(1e100), "1e+100");
+    EXPECT_EQ(format(std::numeric_limits<qz::f64>::infinity()), "inf");
+
+    // the shortest representation round trips, and always fits in max_formatted_size.
+    for (const auto value : {std::numeric_limits<qz::f64>::min(), std::numeric_limits<qz::f64>::lowest(),
+                             -std::numeric_limits<qz::f64>::denorm_min(), 1.0 / 3.0, -2.2250738585072014e-300})
+    {
+        const auto string = format(value);
+        EXPECT_EQ(std::strtod(string.c_str(), nullptr), value) << string;
+    }
+
+    char buffer[16];
+    auto *end = qz::format_to(buffer, buffer + sizeof(buffer), 3.14159, 2);
+    EXPECT_EQ(std::string(buffer, end), "3.14");
+}
+
+TEST(QzFormat, Buffer_Too_Small)
+{
+    char buffer[3];
+    EXPECT_EQ(qz::format_to(buffer, buffer + 3, 1000), nullptr);
+    EXPECT_EQ(qz::format_to(buffer, buffer + 3, -100), nullptr);
+    EXPECT_EQ(qz::format_to(buffer, buffer, -1), nullptr);
+    EXPECT_NE(qz::format_to(buffer, buffer + 3, -99), nullptr);
+    EXPECT_EQ(qz::format_to(buffer, buffer + 3, 0.125), nullptr);
+}
+
+TEST(QzFormat, Small_String)
+{
+    qz::small_string string = "id=";
+    qz::format_to(string, 12345);
+    string += ", ratio=";
+    qz::format_to(string, 0.5);
+    EXPECT_EQ(string, "id=12345, ratio=0.5");
+    EXPECT_TRUE(string.is_inline());
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <quartz/histogram.hpp>
+
+#include <thread>
+#include <vector>
+
+TEST(QzHistogram, Buckets)
+{
+    using histogram = qz::latency_histogram;
+
+    // small values are exact.
+    for (qz::u64 value = 0; value < 64; ++value)
+    {
+        EXPECT_EQ(histogram::bucket_index(value), value);
+        EXPECT_EQ(histogram::bucket_lower_bound(value), value);
+    }
+
+    // every value lies within the bounds of its bucket, and the bucket width is within 1/32 of the value.
+    for (qz::u64 value : {64ULL, 65ULL, 100ULL, 1000ULL, 123456789ULL, 1ULL << 40U, ~0ULL})
+    {
+        const auto index = histogram::bucket_index(value);
+        ASSERT_LT(index, histogram::bucket_count);
+        EXPECT_LE(histogram::bucket_lower_bound(index), value);
+        EXPECT_GE(histogram::bucket_upper_bound(index), value);
+        EXPECT_LE(histogram::bucket_upper_bound(index) - histogram::bucket_lower_bound(index), value / 32);
+    }
+    EXPECT_EQ(histogram::bucket_index(~0ULL), histogram::bucket_count - 1);
+}
+
+TEST(QzHistogram, Percentiles)
+{
+    qz::latency_histogram histogram;
+    EXPECT_EQ(histogram.percentile(50.0), 0);
+
+    for (qz::u64 value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(histogram.count(), 1000);
+    EXPECT_EQ(histogram.min(), 1);
+    EXPECT_EQ(histogram.max(), 1000);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+
+    EXPECT_EQ(histogram.percentile(0.0), 1);
+    EXPECT_EQ(histogram.percentile(100.0), 1000);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(50.0)), 500.0, 500.0 / 32);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(99.0)), 990.0, 990.0 / 32);
+
+    histogram.record(std::chrono::microseconds(5));
+    EXPECT_EQ(histogram.max(), 5000);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0);
+}
+
+TEST(QzHistogram, Merge)
+{
+    qz::latency_histogram histogram_a;
+    qz::latency_histogram histogram_b;
+    histogram_a.record(10, 3);
+    histogram_b.record(2000);
+
+    histogram_a += histogram_b;
+    EXPECT_EQ(histogram_a.count(), 4);
+    EXPECT_EQ(histogram_a.min(), 10);
+    EXPECT_EQ(histogram_a.max(), 2000);
+    EXPECT_EQ(histogram_a.percentile(75.0), 10);
+}
+
+TEST(QzHistogram, Concurrent_Recording)
+{
+    constexpr auto thread_count = 4;
+    constexpr auto value_count  = 10000;
+
+    qz::latency_recorder recorder(thread_count);
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&recorder] {
+            for (qz::u64 value = 1; value <= value_count; ++value)
+            {
+                recorder.record(value);
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto snapshot = recorder.snapshot();
+    EXPECT_EQ(snapshot.count(), thread_count * value_count);
+    EXPECT_EQ(snapshot.min(), 1);
+    EXPECT_EQ(snapshot.max(), value_count);
+
+    recorder.reset();
+    EXPECT_EQ(recorder.snapshot().count(), 0);
+}
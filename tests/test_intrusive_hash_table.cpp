@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <quartz/intrusive_hash_table.hpp>
+
+namespace
+{
+
+struct entry : qz::intrusive_list_hook<>
+{
+    int key;
+    int value;
+};
+
+struct key_of
+{
+    const int &operator()(const entry &element) const
+    {
+        return element.key;
+    }
+};
+
+struct identity_hash
+{
+    qz::usz operator()(int key) const
+    {
+        return static_cast<qz::usz>(key);
+    }
+};
+
+struct constant_hash
+{
+    qz::usz operator()(int /* key */) const
+    {
+        return 0;
+    }
+};
+
+using table_type = qz::intrusive_hash_table<entry, 8, key_of, identity_hash>;
+
+struct pointer_entry : qz::intrusive_list_hook<>
+{
+    alignas(16) char payload[16];
+};
+
+struct address_of
+{
+    const void *operator()(const pointer_entry &element) const
+    {
+        return &element;
+    }
+};
+
+} // namespace
+
+//
+
+TEST(QzIntrusiveHashTable, Insert_Find)
+{
+    entry entries[32];
+    table_type table;
+
+    for (auto i = 0; i < 32; ++i)
+    {
+        entries[i].key   = i;
+        entries[i].value = i * 2;
+        EXPECT_TRUE(table.insert(entries[i]));
+    }
+    EXPECT_EQ(table.size(), 32);
+
+    for (auto i = 0; i < 32; ++i)
+    {
+        const auto *element = table.find(i);
+        ASSERT_NE(element, nullptr);
+        EXPECT_EQ(element, &entries[i]);
+        EXPECT_EQ(element->value, i * 2);
+    }
+    EXPECT_FALSE(table.contains(32));
+
+    // keys are unique.
+    entry duplicate{};
+    duplicate.key = 4;
+    EXPECT_FALSE(table.insert(duplicate));
+    EXPECT_EQ(table.size(), 32);
+
+    table.clear();
+}
+
+TEST(QzIntrusiveHashTable, Erase)
+{
+    entry entries[4];
+    qz::intrusive_hash_table<entry, 8, key_of, constant_hash> table;
+    for (auto i = 0; i < 4; ++i)
+    {
+        entries[i].key = i * 8; // all in the same bucket.
+        table.insert(entries[i]);
+    }
+    EXPECT_EQ(table.bucket_size(table.bucket(0)), 4);
+
+    table.erase(entries[1]);
+    EXPECT_FALSE(table.contains(8));
+    EXPECT_EQ(table.erase(16), &entries[2]);
+    EXPECT_EQ(table.erase(16), nullptr);
+    EXPECT_EQ(table.size(), 2);
+    EXPECT_TRUE(table.contains(0) && table.contains(24));
+
+    table.clear();
+    EXPECT_TRUE(table.empty());
+}
+
+TEST(QzIntrusiveHashTable, Aligned_Keys)
+{
+    // std::hash of pointers and integers is commonly the identity, so aligned keys only differ in their high bits.
+    pointer_entry entries[64];
+    qz::intrusive_hash_table<pointer_entry, 64, address_of> pointers;
+    for (auto &element : entries)
+    {
+        pointers.insert(element);
+    }
+
+    entry multiples[64];
+    qz::intrusive_hash_table<entry, 64, key_of> integers;
+    for (auto i = 0; i < 64; ++i)
+    {
+        multiples[i].key = i * 64;
+        integers.insert(multiples[i]);
+    }
+
+    qz::usz used_pointer_buckets = 0;
+    qz::usz used_integer_buckets = 0;
+    for (qz::usz bucket = 0; bucket < 64; ++bucket)
+    {
+        used_pointer_buckets += pointers.bucket_size(bucket) > 0 ? 1 : 0;
+        used_integer_buckets += integers.bucket_size(bucket) > 0 ? 1 : 0;
+    }
+    EXPECT_GE(used_pointer_buckets, 32);
+    EXPECT_GE(used_integer_buckets, 32);
+    EXPECT_EQ(pointers.find(&entries[17]), &entries[17]);
+
+    pointers.clear();
+    integers.clear();
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <quartz/intrusive_list.hpp>
+
+namespace
+{
+
+struct lru_tag;
+struct timer_tag;
+
+struct entry : qz::intrusive_list_hook<lru_tag>, qz::intrusive_list_hook<timer_tag>
+{
+    explicit entry(int value) : value(value)
+    {
+    }
+
+    int value;
+};
+
+using lru_list   = qz::intrusive_list<entry, lru_tag>;
+using timer_list = qz::intrusive_list<entry, timer_tag>;
+
+int sum_of(const lru_list &list)
+{
+    auto sum = 0;
+    for (const auto &element : list)
+    {
+        sum += element.value;
+    }
+    return sum;
+}
+
+} // namespace
+
+//
+
+TEST(QzIntrusiveList, Push_Pop)
+{
+    entry a{1}, b{2}, c{3};
+    lru_list list;
+    EXPECT_TRUE(list.empty());
+
+    list.push_back(b);
+    list.push_front(a);
+    list.push_back(c);
+
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front().value, 1);
+    EXPECT_EQ(list.back().value, 3);
+    EXPECT_EQ(sum_of(list), 6);
+
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(list.size(), 1);
+    EXPECT_EQ(&list.front(), &b);
+    EXPECT_FALSE(static_cast<qz::intrusive_list_hook<lru_tag> &>(a).is_linked());
+    EXPECT_TRUE(static_cast<qz::intrusive_list_hook<lru_tag> &>(b).is_linked());
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_FALSE(static_cast<qz::intrusive_list_hook<lru_tag> &>(b).is_linked());
+}
+
+TEST(QzIntrusiveList, Erase_Move)
+{
+    entry a{1}, b{2}, c{3};
+    lru_list list;
+    list.push_back(a);
+    list.push_back(b);
+    list.push_back(c);
+
+    // O(1) unlinking from a reference.
+    list.erase(b);
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(sum_of(list), 4);
+
+    // reordering without unlinking, as used for LRU eviction.
+    list.move_to_front(c);
+    EXPECT_EQ(&list.front(), &c);
+    EXPECT_EQ(&list.back(), &a);
+    list.move_to_back(c);
+    EXPECT_EQ(&list.back(), &c);
+
+    auto it = list.erase(list.iterator_to(a));
+    EXPECT_EQ(&*it, &c);
+    EXPECT_EQ(list.size(), 1);
+
+    // moving a list takes over its links.
+    lru_list other = static_cast<lru_list &&>(list);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(other.size(), 1);
+    EXPECT_EQ(&other.front(), &c);
+}
+
+TEST(QzIntrusiveList, Multiple_Hooks)
+{
+    entry a{1}, b{2};
+    lru_list lru;
+    timer_list timers;
+
+    lru.push_back(a);
+    lru.push_back(b);
+    timers.push_back(b);
+
+    EXPECT_EQ(lru.size(), 2);
+    EXPECT_EQ(timers.size(), 1);
+
+    lru.erase(b);
+    EXPECT_EQ(&timers.front(), &b); // still linked through the other hook.
+    timers.clear();
+}
+
+TEST(QzIntrusiveList, Iteration)
+{
+    entry values[] = {entry{0}, entry{1}, entry{2}, entry{3}};
+    lru_list list;
+    for (auto &value : values)
+    {
+        list.push_back(value);
+    }
+
+    auto expected = 3;
+    for (auto it = list.rbegin(); it != list.rend(); ++it)
+    {
+        EXPECT_EQ(it->value, expected--);
+    }
+    list.clear();
+}
+
+TEST(QzIntrusiveList, Double_Insertion)
+{
+#ifndef NDEBUG
+    EXPECT_DEATH(
+        {
+            entry a{1};
+            lru_list list;
+            list.push_back(a);
+            list.push_back(a);
+        },
+        "");
+#endif
+}
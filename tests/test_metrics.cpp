@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <quartz/metrics.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+
+qz::counter g_registered_total("test_registered_total", "Registered during static initialization.");
+QZ_REGISTER_METRIC(g_registered_total);
+qz::gauge g_registered_gauge("test_registered_gauge", "Registered in the same file.");
+QZ_REGISTER_METRIC(g_registered_gauge);
+
+std::string write_all(const qz::metric_registry &registry)
+{
+    char buffer[1024];
+    char *end = registry.write(buffer, buffer + sizeof(buffer));
+    return end == nullptr ? std::string("<overflow>") : std::string(buffer, end);
+}
+
+} // namespace
+
+TEST(QzMetrics, Counter_Gauge)
+{
+    qz::counter requests("requests_total", "Requests handled.", 3);
+    EXPECT_EQ(requests.shard_count(), 4);
+    EXPECT_EQ(requests.type(), qz::metric_type::counter);
+    EXPECT_EQ(requests.value(), 0);
+
+    requests.increment();
+    requests.increment(41);
+    EXPECT_EQ(requests.value(), 42);
+    requests.reset();
+    EXPECT_EQ(requests.value(), 0);
+
+    qz::gauge in_flight("in_flight", "Requests in flight.");
+    EXPECT_EQ(in_flight.shard_count(), qz::metric::default_shard_count);
+    in_flight.increment();
+    in_flight.decrement();
+    in_flight.sub(5);
+    EXPECT_EQ(in_flight.value(), -5);
+    in_flight.add(8);
+    EXPECT_EQ(in_flight.value(), 3);
+    in_flight.set(-100);
+    EXPECT_EQ(in_flight.value(), -100);
+}
+
+TEST(QzMetrics, Concurrent_Updates)
+{
+    constexpr auto thread_count    = 4;
+    constexpr auto increment_count = 100000;
+
+    qz::counter hits("hits_total", "");
+    qz::gauge balance("balance", "");
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&] {
+            for (auto j = 0; j < increment_count; ++j)
+            {
+                hits.increment();
+                balance.add(2);
+                balance.decrement();
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(hits.value(), thread_count * increment_count);
+    EXPECT_EQ(balance.value(), thread_count * increment_count);
+}
+
+TEST(QzMetrics, Registry_Write)
+{
+    qz::metric_registry registry;
+    qz::gauge queue_depth("queue_depth", "Items waiting.\nBackslash: \\");
+    qz::counter assertions("assertion_checks_total", "Assertions checked.");
+    registry.add(queue_depth);
+    registry.add(assertions);
+    EXPECT_EQ(registry.size(), 2);
+
+    queue_depth.set(-3);
+    assertions.increment(7);
+
+    // metrics are ordered by name, and help texts are escaped.
+    EXPECT_EQ(write_all(registry), "# HELP assertion_checks_total Assertions checked.\n"
+                                   "# TYPE assertion_checks_total counter\n"
+                                   "assertion_checks_total 7\n"
+                                   "# HELP queue_depth Items waiting.\\nBackslash: \\\\\n"
+                                   "# TYPE queue_depth gauge\n"
+                                   "queue_depth -3\n");
+
+    char small[16];
+    EXPECT_EQ(registry.write(small, small + sizeof(small)), nullptr);
+
+    // metrics leave their registry when removed or destroyed.
+    registry.remove(queue_depth);
+    {
+        qz::counter scoped("scoped_total", "");
+        registry.add(scoped);
+        EXPECT_EQ(registry.size(), 2);
+    }
+    EXPECT_EQ(registry.size(), 1);
+    EXPECT_EQ(write_all(registry), "# HELP assertion_checks_total Assertions checked.\n"
+                                   "# TYPE assertion_checks_total counter\n"
+                                   "assertion_checks_total 7\n");
+
+    EXPECT_TRUE(qz::metric_registry::is_valid_name("http:requests_total"));
+    EXPECT_TRUE(qz::metric_registry::is_valid_name("_x1"));
+    EXPECT_FALSE(qz::metric_registry::is_valid_name(""));
+    EXPECT_FALSE(qz::metric_registry::is_valid_name("1x"));
+    EXPECT_FALSE(qz::metric_registry::is_valid_name("requests-total"));
+}
+
+TEST(QzMetrics, Invalid_Add)
+{
+    // checked in release builds too, since a broken registry would only show up as missing or unparsable metrics.
+    qz::metric_registry registry;
+    qz::counter requests("requests_total", "");
+    qz::counter duplicate("requests_total", "");
+    qz::counter invalid("requests-total", "");
+    registry.add(requests);
+    EXPECT_DEATH(registry.add(duplicate), "same name");
+    EXPECT_DEATH(registry.add(invalid), "must match");
+    EXPECT_DEATH(registry.add(requests), "already in a registry");
+}
+
+TEST(QzMetrics, Static_Registration)
+{
+    // the metrics are global, so they are reset for repeated runs of the test.
+    g_registered_total.reset();
+    g_registered_total.increment(5);
+    g_registered_gauge.set(9);
+
+    const auto text = write_all(qz::metric_registry::global());
+    EXPECT_NE(text.find("# TYPE test_registered_total counter\ntest_registered_total 5\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE test_registered_gauge gauge\ntest_registered_gauge 9\n"), std::string::npos);
+}
+
+#if !defined(_WIN32)
+TEST(QzMetrics, Write_Fd)
+{
+    // a pipe stands in for the connection of a scraper. The output spans several chunks of the internal buffer.
+    std::vector<std::string> names;
+    names.reserve(200);
+    qz::metric_registry registry;
+    std::vector<std::unique_ptr<qz::counter>> counters;
+    for (auto i = 0; i < 200; ++i)
+    {
+        names.push_back("counter_" + std::to_string(1000 + i) + "_total");
+        counters.push_back(std::make_unique<qz::counter>(names.back(), "A counter with a help text to fill the pipe."));
+        counters.back()->increment(static_cast<qz::u64>(i));
+        registry.add(*counters.back());
+    }
+
+    std::string expected(1 << 16, '\0');
+    expected.resize(static_cast<qz::usz>(registry.write(expected.data(), expected.data() + expected.size()) -
+                                         expected.data()));
+    ASSERT_GT(expected.size(), 4096);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::string received;
+    std::thread scraper([&] {
+        char buffer[1000];
+        for (auto count = read(fds[0], buffer, sizeof(buffer)); count > 0; count = read(fds[0], buffer, sizeof(buffer)))
+        {
+            received.append(buffer, static_cast<qz::usz>(count));
+        }
+    });
+    EXPECT_TRUE(registry.write(fds[1]));
+    close(fds[1]);
+    scraper.join();
+    close(fds[0]);
+    EXPECT_EQ(received, expected);
+
+    EXPECT_FALSE(registry.write(-1));
+}
+
+TEST(QzMetrics, Write_Closed_Socket)
+{
+    // a scraper hanging up must fail the write instead of raising SIGPIPE, which would kill the test.
+    qz::metric_registry registry;
+    qz::counter requests("requests_total", "Requests handled.");
+    registry.add(requests);
+
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    close(fds[1]);
+    EXPECT_FALSE(registry.write(fds[0]));
+    close(fds[0]);
+}
+#endif
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <quartz/optional.hpp>
+
+#include <memory>
+#include <string>
+
+static_assert(std::is_trivially_copyable_v<qz::optional<int>>);
+static_assert(std::is_trivially_destructible_v<qz::optional<int>>);
+static_assert(!std::is_trivially_destructible_v<qz::optional<std::string>>);
+static_assert(sizeof(qz::optional<int &>) == sizeof(int *));
+static_assert(std::is_trivially_copyable_v<qz::optional<int &>>);
+static_assert(!std::is_copy_constructible_v<qz::optional<std::unique_ptr<int>>>);
+static_assert(!std::is_copy_assignable_v<qz::optional<std::unique_ptr<int>>>);
+static_assert(std::is_move_constructible_v<qz::optional<std::unique_ptr<int>>>);
+static_assert(std::is_nothrow_move_assignable_v<qz::optional<std::unique_ptr<int>>>);
+
+namespace
+{
+
+struct immovable
+{
+    immovable()                        = default;
+    immovable(immovable &&)            = delete;
+    immovable &operator=(immovable &&) = delete;
+    ~immovable()                       = default;
+};
+
+struct throwing_move_assign
+{
+    throwing_move_assign()                                 = default;
+    throwing_move_assign(throwing_move_assign &&) noexcept = default;
+    throwing_move_assign &operator=(throwing_move_assign &&) noexcept(false)
+    {
+        return *this;
+    }
+    ~throwing_move_assign() = default;
+};
+
+} // namespace
+
+static_assert(!std::is_move_constructible_v<qz::optional<immovable>>);
+static_assert(!std::is_move_assignable_v<qz::optional<immovable>>);
+static_assert(std::is_nothrow_move_constructible_v<qz::optional<throwing_move_assign>>);
+static_assert(!std::is_nothrow_move_assignable_v<qz::optional<throwing_move_assign>>);
+
+TEST(QzOptional, Values)
+{
+    qz::optional<std::string> empty;
+    EXPECT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.value_or("fallback"), "fallback");
+    EXPECT_DEATH(static_cast<void>(empty.value()), "");
+
+    qz::optional<std::string> value = std::string("value");
+    EXPECT_TRUE(value);
+    EXPECT_EQ(*value, "value");
+    EXPECT_EQ(value->size(), 5);
+
+    // copies and moves carry the value along.
+    auto copy = value;
+    EXPECT_EQ(copy.value(), "value");
+    empty = qz::move(copy);
+    EXPECT_EQ(empty.value(), "value");
+
+    value.reset();
+    EXPECT_FALSE(value.has_value());
+    value.emplace(3, 'x');
+    EXPECT_EQ(value.value(), "xxx");
+
+    value = qz::nullopt;
+    EXPECT_FALSE(value);
+
+    constexpr qz::optional<int> constant = 5;
+    static_assert(constant.value() == 5);
+}
+
+TEST(QzOptional, References)
+{
+    int number = 1;
+
+    qz::optional<int &> reference;
+    EXPECT_FALSE(reference);
+
+    reference = number;
+    ASSERT_TRUE(reference);
+    *reference = 2;
+    EXPECT_EQ(number, 2);
+
+    // assignment rebinds instead of assigning through.
+    int other = 3;
+    reference = other;
+    EXPECT_EQ(number, 2);
+    EXPECT_EQ(&reference.value(), &other);
+
+    qz::optional<const int &> const_reference = reference;
+    EXPECT_EQ(const_reference.value(), 3);
+    EXPECT_EQ(qz::optional<int &>().value_or(7), 7);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <quartz/packed_array.hpp>
+
+#include <algorithm>
+#include <vector>
+
+TEST(QzPackedArray, Get_Set)
+{
+    qz::packed_array<13> array(100);
+    static_assert(std::is_same_v<decltype(array)::value_type, qz::u16>);
+    EXPECT_EQ(array.size(), 100);
+    EXPECT_TRUE(std::all_of(array.begin(), array.end(), [](auto value) { return value == 0; }));
+
+    // values straddle word boundaries at every 64 / gcd(13, 64) positions.
+    for (qz::usz i = 0; i < array.size(); ++i)
+    {
+        array[i] = static_cast<qz::u16>((i * 977) & array.max_value);
+    }
+    for (qz::usz i = 0; i < array.size(); ++i)
+    {
+        EXPECT_EQ(array[i], (i * 977) & array.max_value) << i;
+    }
+
+    // overwriting a value leaves its neighbours untouched.
+    array[4] = 0x1FFF;
+    array[5] = 0;
+    EXPECT_EQ(array.get(3), (3 * 977) & array.max_value);
+    EXPECT_EQ(array.get(4), 0x1FFF);
+    EXPECT_EQ(array.get(5), 0);
+    EXPECT_EQ(array.get(6), (6 * 977) & array.max_value);
+
+    // 100 13-bit values fit in 21 words, plus a word of padding.
+    EXPECT_EQ(array.size_bytes(), 22 * sizeof(qz::u64));
+}
+
+TEST(QzPackedArray, Full_Width)
+{
+    qz::packed_array<64> wide = {~qz::u64{0}, 1, 0x8000000000000000ULL};
+    EXPECT_EQ(wide[0], ~qz::u64{0});
+    EXPECT_EQ(wide[1], 1);
+    EXPECT_EQ(wide[2], 0x8000000000000000ULL);
+
+    qz::packed_array<1> bits;
+    for (auto i = 0; i < 130; ++i)
+    {
+        bits.push_back(static_cast<qz::u8>(i % 3 == 0));
+    }
+    EXPECT_EQ(std::count(bits.begin(), bits.end(), 1), 44);
+}
+
+TEST(QzPackedArray, Resize_Decode)
+{
+    qz::packed_array<7> array;
+    for (qz::u8 i = 0; i < 100; ++i)
+    {
+        array.push_back(i);
+    }
+
+    // shrinking and growing again yields zeros, not the old values.
+    array.resize(10);
+    array.resize(20);
+    EXPECT_EQ(array[9], 9);
+    EXPECT_EQ(array[10], 0);
+    EXPECT_EQ(array[19], 0);
+
+    qz::u8 chunk[8];
+    EXPECT_EQ(array.decode(4, chunk), 8);
+    EXPECT_EQ(chunk[0], 4);
+    EXPECT_EQ(chunk[5], 9);
+    EXPECT_EQ(chunk[6], 0);
+    EXPECT_EQ(array.decode(16, chunk), 4);
+    EXPECT_EQ(array.decode(20, chunk), 0);
+    EXPECT_EQ(array.end() - array.begin(), 20);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <quartz/pipeline.hpp>
+
+#include <algorithm>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+qz::generator<int> iota(int count)
+{
+    for (auto i = 0; i < count; ++i)
+    {
+        co_yield i;
+    }
+}
+
+template <class Pipeline>
+concept runs_as_lvalue = requires(Pipeline &pipeline) { pipeline.run([](auto /* unused */) {}); };
+
+} // namespace
+
+TEST(QzPipeline, Stages_Batches)
+{
+    std::vector<std::string> output;
+    std::vector<qz::usz> batch_sizes;
+
+    auto pipeline = qz::pipeline(iota(1000), 64)
+                        .then([](qz::frame_arena &, std::span<const int> batch) -> qz::generator<int> {
+                            for (const auto value : batch)
+                            {
+                                if (value % 3 == 0)
+                                {
+                                    co_yield value;
+                                }
+                            }
+                        })
+                        .then([](std::span<const int> batch) -> qz::generator<std::string> {
+                            for (const auto value : batch)
+                            {
+                                co_yield std::to_string(value * 2);
+                            }
+                        });
+    static_assert(!runs_as_lvalue<decltype(pipeline)>, "Running is expected to consume the pipeline.");
+    qz::move(pipeline).run([&](std::span<const std::string> batch) {
+        batch_sizes.push_back(batch.size());
+        output.insert(output.end(), batch.begin(), batch.end());
+    });
+
+    ASSERT_EQ(output.size(), 334);
+    for (qz::usz i = 0; i < output.size(); ++i)
+    {
+        EXPECT_EQ(output[i], std::to_string(i * 6));
+    }
+
+    // every batch is full except for the last one.
+    for (qz::usz i = 0; i + 1 < batch_sizes.size(); ++i)
+    {
+        EXPECT_EQ(batch_sizes[i], 64);
+    }
+    EXPECT_EQ(batch_sizes.back(), 334 % 64);
+}
+
+TEST(QzPipeline, Expanding_Stage)
+{
+    // a stage may produce more items than it receives, which spill over into several downstream batches.
+    qz::usz total = 0;
+    qz::usz count = 0;
+    qz::pipeline(iota(10), 4)
+        .then([](std::span<const int> batch) -> qz::generator<int> {
+            for (const auto value : batch)
+            {
+                for (auto i = 0; i < value; ++i)
+                {
+                    co_yield value;
+                }
+            }
+        })
+        .run([&](std::span<const int> batch) {
+            EXPECT_LE(batch.size(), 4);
+            count += batch.size();
+            for (const auto value : batch)
+            {
+                total += value;
+            }
+        });
+    EXPECT_EQ(count, 45);
+    EXPECT_EQ(total, 285);
+
+    // without stages, the sink receives the batches of the source.
+    count = 0;
+    qz::pipeline(iota(10), 3).run([&](std::span<const int> batch) { count += batch.size(); });
+    EXPECT_EQ(count, 10);
+}
+
+TEST(QzPipeline, Span_Stages)
+{
+    // sources and stages yielding spans pass on many items per resume, which are rebatched at the batch size.
+    auto chunks = []() -> qz::generator<std::span<const int>> {
+        std::vector<int> chunk;
+        for (auto i = 0; i < 100; i += 7)
+        {
+            chunk.clear();
+            for (auto j = i; j < std::min(i + 7, 100); ++j)
+            {
+                chunk.push_back(j);
+            }
+            co_yield chunk;
+        }
+    };
+
+    std::vector<int> output;
+    qz::pipeline(chunks(), 10)
+        .then([buffer = std::vector<int>()](std::span<const int> batch) mutable -> qz::generator<std::span<const int>> {
+            buffer.clear();
+            for (const auto value : batch)
+            {
+                buffer.push_back(value + 1);
+            }
+            co_yield buffer;
+        })
+        .run([&](std::span<const int> batch) {
+            EXPECT_LE(batch.size(), 10);
+            output.insert(output.end(), batch.begin(), batch.end());
+        });
+
+    ASSERT_EQ(output.size(), 100);
+    for (auto i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(output[static_cast<qz::usz>(i)], i + 1);
+    }
+}
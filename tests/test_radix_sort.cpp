@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <quartz/radix_sort.hpp>
+#include <quartz/random.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+template <class T>
+std::vector<T> random_keys(qz::usz count, qz::u64 seed)
+{
+    qz::xoshiro256pp engine(seed);
+    std::vector<T> keys(count);
+    for (auto &key : keys)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            key = qz::uniform_real<T>(engine, T{-1e6}, T{1e6});
+        }
+        else
+        {
+            key = static_cast<T>(engine());
+        }
+    }
+    return keys;
+}
+
+template <class T>
+void expect_sorted_like_std(std::vector<T> keys, qz::usz thread_count)
+{
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+    qz::radix_sort(std::span(keys), thread_count);
+    EXPECT_EQ(keys, expected);
+}
+
+} // namespace
+
+TEST(QzRadixSort, Keys)
+{
+    // sizes around the insertion sort cut-off, and large enough to use several threads.
+    for (const qz::usz size : {0, 1, 63, 64, 1000, 300000})
+    {
+        for (const qz::usz threads : {1, 4})
+        {
+            expect_sorted_like_std(random_keys<qz::u8>(size, 1), threads);
+            expect_sorted_like_std(random_keys<qz::u32>(size, 2), threads);
+            expect_sorted_like_std(random_keys<qz::u64>(size, 3), threads);
+            expect_sorted_like_std(random_keys<qz::s16>(size, 4), threads);
+            expect_sorted_like_std(random_keys<qz::s64>(size, 5), threads);
+            expect_sorted_like_std(random_keys<qz::f32>(size, 6), threads);
+            expect_sorted_like_std(random_keys<qz::f64>(size, 7), threads);
+        }
+    }
+}
+
+TEST(QzRadixSort, Float_Order)
+{
+    constexpr auto inf = std::numeric_limits<qz::f32>::infinity();
+    std::vector<qz::f32> keys{3.5F, -0.0F, inf, -1.0F, 0.0F, -inf, 1e-40F, -2.5e10F, 1.0F, -1e-40F};
+    for (auto i = 0; i < 100; ++i)
+    {
+        keys.push_back(static_cast<qz::f32>(i % 7) - 3.0F);
+    }
+    qz::radix_sort(std::span(keys));
+
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    EXPECT_EQ(keys.front(), -inf);
+    EXPECT_EQ(keys.back(), inf);
+
+    // negative zero orders before positive zero.
+    const auto zero = std::find(keys.begin(), keys.end(), 0.0F);
+    EXPECT_TRUE(std::signbit(*zero));
+    EXPECT_FALSE(std::signbit(*(zero + 1)));
+
+    // nans go to the end matching their sign.
+    std::vector<qz::f32> nans{1.0F, std::numeric_limits<qz::f32>::quiet_NaN(), -1.0F};
+    nans.push_back(-std::numeric_limits<qz::f32>::quiet_NaN());
+    qz::radix_sort(std::span(nans));
+    EXPECT_TRUE(std::isnan(nans.front()) && std::signbit(nans.front()));
+    EXPECT_TRUE(std::isnan(nans.back()) && !std::signbit(nans.back()));
+}
+
+TEST(QzRadixSort, Skipped_Passes)
+{
+    // only the low byte differs, so a single pass sorts the keys and leaves them in the scratch buffer.
+    std::vector<qz::u64> keys;
+    for (qz::u64 i = 0; i < 5000; ++i)
+    {
+        keys.push_back(0xABCD'0000'0000'0000 | ((i * 37) % 256));
+    }
+    expect_sorted_like_std(keys, 1);
+    expect_sorted_like_std(keys, 2);
+
+    // half of the keys are zero, so the bucket of zeros is too large for the caches and gets split again.
+    auto skewed = random_keys<qz::u64>(300000, 8);
+    for (qz::usz i = 0; i < skewed.size(); i += 2)
+    {
+        skewed[i] = 0;
+    }
+    expect_sorted_like_std(skewed, 1);
+    expect_sorted_like_std(skewed, 4);
+
+    // all keys equal, so nothing is moved at all.
+    expect_sorted_like_std(std::vector<qz::u32>(1000, 42U), 1);
+}
+
+TEST(QzRadixSort, Values_Indices)
+{
+    // the sort is stable, so equal keys keep the order of their values.
+    auto keys = random_keys<qz::u32>(200000, 9);
+    for (auto &key : keys)
+    {
+        key %= 1000;
+    }
+    const auto original = keys;
+
+    std::vector<qz::u32> indices(keys.size());
+    qz::radix_sort_indices(std::span<const qz::u32>(keys), std::span(indices), 3);
+    for (qz::usz i = 1; i < indices.size(); ++i)
+    {
+        const auto previous = keys[indices[i - 1]];
+        const auto current  = keys[indices[i]];
+        ASSERT_TRUE(previous < current || (previous == current && indices[i - 1] < indices[i]));
+    }
+    EXPECT_EQ(keys, original);
+
+    std::vector<qz::f64> values(keys.size());
+    for (qz::usz i = 0; i < keys.size(); ++i)
+    {
+        values[i] = static_cast<qz::f64>(i);
+    }
+    qz::radix_sort(std::span(keys), std::span(values));
+    for (qz::usz i = 0; i < keys.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<qz::u32>(values[i]), indices[i]);
+    }
+}
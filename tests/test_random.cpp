@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <quartz/random.hpp>
+
+#include <random>
+
+namespace
+{
+
+// lookup tables may be seeded at compile time.
+constexpr auto g_table = [] {
+    qz::xoshiro256pp engine(42);
+    qz::array<qz::u64, 8> table{};
+    for (auto &value : table)
+    {
+        value = qz::uniform_int(engine, 100);
+    }
+    return table;
+}();
+
+} // namespace
+
+//
+
+static_assert(std::uniform_random_bit_generator<qz::splitmix64>);
+static_assert(std::uniform_random_bit_generator<qz::xoshiro256pp>);
+static_assert(std::uniform_random_bit_generator<qz::pcg64>);
+
+TEST(QzRandom, Reference_Values)
+{
+    // first outputs of the reference splitmix64.c implementation seeded with zero.
+    qz::splitmix64 splitmix(0);
+    EXPECT_EQ(splitmix(), 0xE220A8397B1DCDAFU);
+    EXPECT_EQ(splitmix(), 0x6E789E6AA1B965F4U);
+
+    // reference xoshiro256plusplus.c with the state {1, 2, 3, 4}.
+    qz::xoshiro256pp xoshiro(qz::array<qz::u64, 4>{1, 2, 3, 4});
+    EXPECT_EQ(xoshiro(), 41943041U);
+    EXPECT_EQ(xoshiro(), 58720359U);
+
+    // reference pcg64_srandom_r(42, 54), as in check-pcg64.c of the PCG C library.
+    qz::pcg64 pcg(42, 54);
+    EXPECT_EQ(pcg(), 0x86B1DA1D72062B68U);
+    EXPECT_EQ(pcg(), 0x1304AA46C9853D39U);
+    EXPECT_EQ(pcg(), 0xA3670E9E0DD50358U);
+
+    // a stream selector with the top bit set, which must reach the high half of the increment.
+    qz::pcg64 high_stream(0x853C49E6748FEA9BU, 0xDA3E39CB94B95BDBU);
+    EXPECT_EQ(high_stream(), 0x9EAAD51469F97EE3U);
+    EXPECT_EQ(high_stream(), 0x2F50C4468F2E8CBEU);
+    EXPECT_EQ(high_stream(), 0xF1BFB51734332233U);
+}
+
+TEST(QzRandom, Compile_Time_Seeding)
+{
+    for (auto value : g_table)
+    {
+        EXPECT_LT(value, 100);
+    }
+
+    qz::xoshiro256pp engine(42);
+    for (auto value : g_table)
+    {
+        EXPECT_EQ(value, qz::uniform_int(engine, 100)); // matches the run time sequence.
+    }
+}
+
+TEST(QzRandom, Jump_Ahead)
+{
+    // pcg64::advance is equivalent to stepping the engine.
+    qz::pcg64 stepped(7, 3);
+    qz::pcg64 advanced(7, 3);
+    for (auto i = 0; i < 1000; ++i)
+    {
+        static_cast<void>(stepped());
+    }
+    advanced.advance(1000);
+    EXPECT_EQ(stepped, advanced);
+    EXPECT_EQ(stepped(), advanced());
+
+    // different streams produce different sequences.
+    qz::pcg64 stream_a(7, 1);
+    qz::pcg64 stream_b(7, 2);
+    EXPECT_NE(stream_a(), stream_b());
+    qz::pcg64 stream_c(7, 1U | (qz::u64{1} << 63U));
+    EXPECT_NE(qz::pcg64(7, 1)(), stream_c());
+
+    // jumping changes the state deterministically.
+    qz::xoshiro256pp engine_a(1), engine_b(1);
+    engine_a.jump();
+    engine_b.jump();
+    EXPECT_EQ(engine_a, engine_b);
+    engine_b.long_jump();
+    EXPECT_NE(engine_a(), engine_b());
+}
+
+TEST(QzRandom, Batch_Lanes)
+{
+    qz::xoshiro256pp_batch<4> batch(123);
+
+    qz::array<qz::u64, 4 * 16 + 3> buffer{};
+    batch.fill(buffer);
+
+    // lane i matches a scalar engine jumped i times.
+    for (qz::usz lane = 0; lane < 4; ++lane)
+    {
+        qz::xoshiro256pp scalar(123);
+        for (qz::usz i = 0; i < lane; ++i)
+        {
+            scalar.jump();
+        }
+        for (qz::usz pos = lane; pos < buffer.size(); pos += 4)
+        {
+            EXPECT_EQ(buffer[pos], scalar());
+        }
+    }
+}
+
+TEST(QzRandom, Bounded_Values)
+{
+    qz::xoshiro256pp engine(99);
+
+    qz::usz histogram[10] = {};
+    for (auto i = 0; i < 100000; ++i)
+    {
+        auto value = qz::uniform_int(engine, 10);
+        ASSERT_LT(value, 10);
+        ++histogram[value];
+    }
+    for (auto count : histogram)
+    {
+        EXPECT_NEAR(static_cast<double>(count), 10000.0, 500.0);
+    }
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto value = qz::uniform_int(engine, -5, 5);
+        EXPECT_TRUE(value >= -5 && value <= 5);
+
+        auto real = qz::uniform_real<qz::f64>(engine);
+        EXPECT_TRUE(real >= 0.0 && real < 1.0);
+
+        auto real_range = qz::uniform_real<qz::f32>(engine, -2.0F, 2.0F);
+        EXPECT_TRUE(real_range >= -2.0F && real_range < 2.0F);
+    }
+
+    // works with the standard distributions too.
+    std::normal_distribution<double> normal;
+    static_cast<void>(normal(engine));
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <quartz/slot_map.hpp>
+
+#include <string>
+
+TEST(QzSlotMap, Insert_Find)
+{
+    qz::slot_map<std::string> map;
+    EXPECT_TRUE(map.empty());
+
+    auto handle_a = map.insert("a");
+    auto handle_b = map.emplace(3, 'b');
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_TRUE(map.contains(handle_a) && map.contains(handle_b));
+    EXPECT_EQ(map[handle_a], "a");
+    EXPECT_EQ(map.at(handle_b), "bbb");
+    EXPECT_EQ(*map.find(handle_b), "bbb");
+
+    // null handles never refer to a value.
+    EXPECT_FALSE(map.contains(qz::slot_map_handle{}));
+    EXPECT_EQ(map.find(qz::slot_map_handle{}), nullptr);
+#if defined(QZ_NO_EXCEPTIONS)
+    EXPECT_DEATH(static_cast<void>(map.at(qz::slot_map_handle{})), "");
+#else
+    EXPECT_THROW(static_cast<void>(map.at(qz::slot_map_handle{})), std::out_of_range);
+#endif
+    EXPECT_FALSE(map.try_at(qz::slot_map_handle{}).has_value());
+    EXPECT_EQ(map.try_at(handle_a).value(), "a");
+
+    // handles survive a round trip through their 64-bit representation.
+    EXPECT_EQ(qz::slot_map_handle::from_u64(handle_b.to_u64()), handle_b);
+}
+
+TEST(QzSlotMap, Erase_Stale_Handles)
+{
+    qz::slot_map<int> map;
+
+    auto handle_a = map.insert(1);
+    auto handle_b = map.insert(2);
+    auto handle_c = map.insert(3);
+
+    EXPECT_TRUE(map.erase(handle_a));
+    EXPECT_FALSE(map.erase(handle_a)); // already erased.
+    EXPECT_FALSE(map.contains(handle_a));
+    EXPECT_EQ(map.size(), 2);
+
+    // remaining handles still refer to their values after the swap with the last value.
+    EXPECT_EQ(map[handle_b], 2);
+    EXPECT_EQ(map[handle_c], 3);
+
+    // the freed slot is reused, but the old handle stays stale.
+    auto handle_d = map.insert(4);
+    EXPECT_EQ(handle_d.index, handle_a.index);
+    EXPECT_NE(handle_d, handle_a);
+    EXPECT_FALSE(map.contains(handle_a));
+    EXPECT_EQ(map[handle_d], 4);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(handle_b) || map.contains(handle_c) || map.contains(handle_d));
+}
+
+TEST(QzSlotMap, Forged_Handles)
+{
+    qz::slot_map<int> map;
+
+    auto handle_a = map.insert(1);
+    auto handle_b = map.insert(2);
+    auto handle_c = map.insert(3);
+    EXPECT_TRUE(map.erase(handle_a));
+    EXPECT_TRUE(map.erase(handle_b));
+
+    // handles matching the generation of an empty slot, whose free list links would index past the values (a) or
+    // at the value of another slot (b).
+    const auto forged_a = qz::slot_map_handle::from_u64(handle_a.to_u64() + (1ULL << 32U));
+    const auto forged_b = qz::slot_map_handle::from_u64(handle_b.to_u64() + (1ULL << 32U));
+    for (const auto handle : {forged_a, forged_b})
+    {
+        EXPECT_FALSE(map.contains(handle));
+        EXPECT_EQ(map.find(handle), nullptr);
+        EXPECT_FALSE(map.try_at(handle).has_value());
+        EXPECT_FALSE(map.erase(handle));
+    }
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map[handle_c], 3);
+}
+
+TEST(QzSlotMap, Dense_Iteration)
+{
+    qz::slot_map<int> map;
+    qz::slot_map_handle handles[8];
+    for (auto i = 0; i < 8; ++i)
+    {
+        handles[i] = map.insert(i);
+    }
+    for (auto i = 0; i < 8; i += 2)
+    {
+        map.erase(handles[i]);
+    }
+
+    auto sum = 0;
+    for (auto value : map)
+    {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 1 + 3 + 5 + 7);
+    EXPECT_EQ(map.end() - map.begin(), 4);
+
+    // every dense position maps back to a handle referring to the same value.
+    for (qz::usz i = 0; i < map.size(); ++i)
+    {
+        EXPECT_EQ(&map[map.handle_at(i)], map.data() + i);
+    }
+}
+
+TEST(QzSlotMap, Fixed_Capacity)
+{
+    qz::fixed_slot_map<int, 4> map;
+    EXPECT_EQ(map.max_size(), 4);
+
+    qz::slot_map_handle handles[4];
+    for (auto i = 0; i < 4; ++i)
+    {
+        handles[i] = map.insert(i * 10);
+    }
+    EXPECT_TRUE(map.full());
+    // verified in release builds too, rather than writing past the fixed arrays.
+    EXPECT_DEATH(map.insert(40), "full");
+
+    EXPECT_TRUE(map.erase(handles[1]));
+    EXPECT_FALSE(map.full());
+
+    auto handle = map.insert(50);
+    EXPECT_EQ(map[handle], 50);
+    EXPECT_EQ(map[handles[3]], 30);
+    EXPECT_FALSE(map.contains(handles[1]));
+}
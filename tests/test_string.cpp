@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <quartz/string.hpp>
+
+#include <memory>
+#include <string>
+
+namespace
+{
+
+template <qz::fixed_string Name>
+struct named
+{
+    static constexpr std::string_view name = Name;
+};
+
+// counts the live allocations made through it.
+template <class T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator(int *live) : live(live)
+    {
+    }
+
+    template <class U>
+    counting_allocator(const counting_allocator<U> &other) : live(other.live)
+    {
+    }
+
+    T *allocate(qz::usz count)
+    {
+        ++*live;
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *pointer, qz::usz count)
+    {
+        --*live;
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    bool operator==(const counting_allocator &) const = default;
+
+    int *live;
+};
+
+} // namespace
+
+TEST(QzFixedString, Constant_Evaluation)
+{
+    constexpr qz::fixed_string hello = "hello";
+    static_assert(hello.size() == 5);
+    static_assert(hello[1] == 'e');
+    static_assert(hello.view() == "hello");
+
+    constexpr auto greeting = hello + qz::fixed_string(", world");
+    static_assert(greeting.size() == 12);
+    static_assert(greeting == qz::fixed_string("hello, world"));
+    static_assert(hello < greeting);
+    EXPECT_STREQ(greeting.c_str(), "hello, world");
+
+    // usable as a template argument, with equal strings naming the same specialization.
+    static_assert(named<"counter">::name == "counter");
+    static_assert(std::is_same_v<named<"counter">, named<"counter">>);
+    static_assert(!std::is_same_v<named<"counter">, named<"gauge">>);
+}
+
+TEST(QzSmallString, Inline_Storage)
+{
+    static_assert(sizeof(qz::small_string) == 24);
+    static_assert(qz::small_string::inline_capacity == 23);
+
+    qz::small_string string;
+    EXPECT_TRUE(string.empty());
+    EXPECT_STREQ(string.c_str(), "");
+
+    // exactly 23 characters still fit inline, with the tag byte acting as the null terminator.
+    string = "abcdefghijklmnopqrstuvw";
+    EXPECT_TRUE(string.is_inline());
+    EXPECT_EQ(string.size(), 23);
+    EXPECT_EQ(string.capacity(), 23);
+    EXPECT_STREQ(string.c_str(), "abcdefghijklmnopqrstuvw");
+
+    string.pop_back();
+    string += '!';
+    EXPECT_EQ(string, "abcdefghijklmnopqrstuv!");
+}
+
+TEST(QzSmallString, Heap_Storage)
+{
+    int live = 0;
+    qz::basic_small_string<counting_allocator<char>> string("short", counting_allocator<char>(&live));
+    EXPECT_EQ(live, 0);
+
+    string += " string which no longer fits inline";
+    EXPECT_FALSE(string.is_inline());
+    EXPECT_EQ(live, 1);
+    EXPECT_EQ(string, "short string which no longer fits inline");
+    EXPECT_STREQ(string.c_str(), "short string which no longer fits inline");
+
+    // appending the string to itself copies it before releasing the old storage.
+    string.append(string);
+    EXPECT_EQ(string.size(), 80);
+    EXPECT_EQ(string.view().substr(40), "short string which no longer fits inline");
+    EXPECT_EQ(live, 1);
+
+    auto copy = string;
+    EXPECT_EQ(live, 2);
+    auto moved = qz::move(copy);
+    EXPECT_EQ(live, 2);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved, string);
+
+    string.clear();
+    EXPECT_TRUE(string.empty());
+    EXPECT_GE(string.capacity(), 80);
+}
+
+TEST(QzSmallString, Resize)
+{
+    qz::small_string string(3, 'x');
+    EXPECT_EQ(string, "xxx");
+
+    string.resize(30, 'y');
+    EXPECT_EQ(string.size(), 30);
+    EXPECT_EQ(string[29], 'y');
+
+    string.resize(2);
+    EXPECT_EQ(string, "xx");
+    EXPECT_LT(string, "xy");
+    EXPECT_EQ(std::string(string.begin(), string.end()), "xx");
+}
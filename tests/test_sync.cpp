@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <quartz/sync.hpp>
+
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+template <class Lock>
+void expect_mutual_exclusion()
+{
+    constexpr auto thread_count    = 4;
+    constexpr auto iteration_count = 20000;
+
+    Lock lock;
+    auto counter = 0;
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&] {
+            for (auto j = 0; j < iteration_count; ++j)
+            {
+                std::lock_guard guard(lock);
+                ++counter;
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter, thread_count * iteration_count);
+}
+
+struct snapshot
+{
+    qz::u64 a;
+    qz::u64 b;
+    qz::u64 c;
+};
+
+} // namespace
+
+//
+
+TEST(QzSync, Spinlock)
+{
+    qz::spinlock lock;
+    EXPECT_TRUE(lock.try_lock());
+    EXPECT_FALSE(lock.try_lock());
+    lock.unlock();
+
+    expect_mutual_exclusion<qz::spinlock>();
+}
+
+TEST(QzSync, Mutex)
+{
+    qz::mutex lock;
+    EXPECT_TRUE(lock.try_lock());
+    EXPECT_FALSE(lock.try_lock());
+    lock.unlock();
+
+    expect_mutual_exclusion<qz::mutex>();
+}
+
+TEST(QzSync, RwSpinlock)
+{
+    qz::rw_spinlock lock;
+
+    // multiple readers at once, but no writer while reading.
+    EXPECT_TRUE(lock.try_lock_shared());
+    EXPECT_TRUE(lock.try_lock_shared());
+    EXPECT_FALSE(lock.try_lock());
+    lock.unlock_shared();
+    lock.unlock_shared();
+
+    // no readers while writing.
+    EXPECT_TRUE(lock.try_lock());
+    EXPECT_FALSE(lock.try_lock_shared());
+    lock.unlock();
+
+    expect_mutual_exclusion<qz::rw_spinlock>();
+
+    {
+        std::shared_lock guard(lock);
+        EXPECT_FALSE(lock.try_lock());
+    }
+}
+
+TEST(QzSync, Seqlock)
+{
+    qz::seqlock<snapshot> lock;
+    EXPECT_EQ(lock.load().a, 0);
+
+    std::atomic<bool> done = false;
+    std::thread writer([&] {
+        for (qz::u64 i = 1; i <= 20000; ++i)
+        {
+            lock.store({.a = i, .b = i * 2, .c = i * 3});
+        }
+        done = true;
+    });
+
+    // readers must never observe a torn value.
+    auto torn_reads = 0;
+    while (!done)
+    {
+        auto value = lock.load();
+        torn_reads += static_cast<int>(value.b != value.a * 2 || value.c != value.a * 3);
+    }
+    writer.join();
+
+    EXPECT_EQ(torn_reads, 0);
+    EXPECT_EQ(lock.load().a, 20000);
+}